@@ -25,6 +25,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstddef>
 #include <memory> /* :( */
 #include <vector>
 #include <pybind11/pybind11.h>
@@ -51,11 +52,51 @@ template<class T> struct PyFramebufferHolder: std::unique_ptr<T, PyNonDestructib
     explicit PyFramebufferHolder(T* object): std::unique_ptr<T, PyNonDestructibleBaseDeleter<T, std::is_destructible<T>::value>>{object} {}
 
     std::vector<pybind11::object> attachments;
+
+    /* Single-sample framebuffer used for resolving multisample contents,
+       created on first use. Recreated if the size or format changes. */
+    pybind11::object resolve;
+    UnsignedInt resolveFormat{};
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+/* Buffers attached to a transform feedback, indexed by their binding index */
+template<class T> struct PyTransformFeedbackHolder: std::unique_ptr<T> {
+    static_assert(std::is_same<T, GL::TransformFeedback>::value, "transform feedback holder has to hold a transform feedback");
+
+    explicit PyTransformFeedbackHolder(T* object): std::unique_ptr<T>{object} {}
+
+    std::vector<pybind11::object> buffers;
+};
+#endif
+
+/* Functions exported by the gl module for other modules drawing natively,
+   such as shaders.*.draw_batch() or the native scenegraph drawables. Each
+   module is a separate library with its own copy of globals, so the pending
+   asynchronous links and renderer statistics can't be accessed directly. */
+struct PyHooks {
+    /* Checks a pending asynchronous link of given program, throwing on
+       failure, and counts given number of draws with it */
+    void(*draw)(AbstractShaderProgram&, std::size_t);
+    /* Discards renderer state tracked for the current GL context, called
+       after a new context is created as it can reuse the address of a
+       destroyed one */
+    void(*contextCreated)();
+};
+
+/* The hooks are imported on first use, at which point the gl module is
+   already loaded */
+inline const PyHooks& pyHooks() {
+    static const PyHooks& hooks = *static_cast<const PyHooks*>(pybind11::reinterpret_borrow<pybind11::capsule>(pybind11::module::import("magnum.gl").attr("_hooks")));
+    return hooks;
+}
+
 }}
 
 PYBIND11_DECLARE_HOLDER_TYPE(T, Magnum::GL::PyMeshHolder<T>)
 PYBIND11_DECLARE_HOLDER_TYPE(T, Magnum::GL::PyFramebufferHolder<T>)
+#ifndef MAGNUM_TARGET_GLES2
+PYBIND11_DECLARE_HOLDER_TYPE(T, Magnum::GL::PyTransformFeedbackHolder<T>)
+#endif
 
 #endif
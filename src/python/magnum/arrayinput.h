@@ -0,0 +1,327 @@
+#ifndef magnum_arrayinput_h
+#define magnum_arrayinput_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <type_traits>
+#include <Python.h>
+#include <pybind11/pybind11.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/Magnum.h>
+
+#include "corrade/PyBuffer.h"
+#include "magnum/bootstrap.h"
+
+namespace magnum {
+
+/* Buffer formats accepted for given component type. Floating-point types are
+   converted from either a float or a double buffer, integer types accept
+   only the exactly matching 32-bit format. */
+template<class> struct ArrayInputFormat;
+template<> struct ArrayInputFormat<Float> {
+    static bool accepts(char format) { return format == 'f' || format == 'd'; }
+    static const char* name() { return "f or d"; }
+    enum: char { Native = 'f' };
+};
+template<> struct ArrayInputFormat<Double> {
+    static bool accepts(char format) { return format == 'f' || format == 'd'; }
+    static const char* name() { return "f or d"; }
+    enum: char { Native = 'd' };
+};
+template<> struct ArrayInputFormat<Int> {
+    static bool accepts(char format) { return format == 'i'; }
+    static const char* name() { return "i"; }
+    enum: char { Native = 'i' };
+};
+template<> struct ArrayInputFormat<UnsignedInt> {
+    static bool accepts(char format) { return format == 'I'; }
+    static const char* name() { return "I"; }
+    enum: char { Native = 'I' };
+};
+
+/* Describes the buffer shape of a vector, (N, size) */
+template<class T, class = void> struct ArrayInputTraits {
+    enum: int { Dimensions = 2 };
+
+    static bool checkShape(const Py_buffer& buffer) {
+        if(buffer.shape[1] == Py_ssize_t(T::Size)) return true;
+        PyErr_Format(PyExc_BufferError, "expected %zu components but got %zi", std::size_t(T::Size), buffer.shape[1]);
+        return false;
+    }
+
+    static bool isContiguous(const Py_buffer& buffer) {
+        return buffer.strides[0] == sizeof(T) && buffer.strides[1] == sizeof(typename T::Type);
+    }
+
+    static const char* component(const char* item, const Py_buffer& buffer, std::size_t i) {
+        return item + i*buffer.strides[1];
+    }
+
+    static void layout(std::size_t size, Py_ssize_t* shape, Py_ssize_t* strides) {
+        shape[0] = size;
+        shape[1] = T::Size;
+        strides[0] = sizeof(T);
+        strides[1] = sizeof(typename T::Type);
+    }
+};
+
+/* Describes the buffer shape of a matrix, (N, rows, cols), with component
+   order in the buffer being column-major to match the matrix memory layout */
+template<class T> struct ArrayInputTraits<T, decltype(void(T::Cols))> {
+    enum: int { Dimensions = 3 };
+
+    static bool checkShape(const Py_buffer& buffer) {
+        if(buffer.shape[1] == Py_ssize_t(T::Rows) && buffer.shape[2] == Py_ssize_t(T::Cols)) return true;
+        PyErr_Format(PyExc_BufferError, "expected %zux%zu elements but got %zix%zi", std::size_t(T::Cols), std::size_t(T::Rows), buffer.shape[2], buffer.shape[1]);
+        return false;
+    }
+
+    static bool isContiguous(const Py_buffer& buffer) {
+        return buffer.strides[0] == sizeof(T) && buffer.strides[1] == sizeof(typename T::Type) && buffer.strides[2] == sizeof(typename T::Type)*T::Rows;
+    }
+
+    static const char* component(const char* item, const Py_buffer& buffer, std::size_t i) {
+        return item + (i%T::Rows)*buffer.strides[1] + (i/T::Rows)*buffer.strides[2];
+    }
+
+    static void layout(std::size_t size, Py_ssize_t* shape, Py_ssize_t* strides) {
+        shape[0] = size;
+        shape[1] = T::Rows;
+        shape[2] = T::Cols;
+        strides[0] = sizeof(T);
+        strides[1] = sizeof(typename T::Type);
+        strides[2] = sizeof(typename T::Type)*T::Rows;
+    }
+};
+
+/* Describes the buffer shape of a one-component vector, which is just (N) */
+template<class T> struct ArrayInputTraits<T, typename std::enable_if<T::Size == 1>::type> {
+    enum: int { Dimensions = 1 };
+
+    static bool checkShape(const Py_buffer&) { return true; }
+
+    static bool isContiguous(const Py_buffer& buffer) {
+        return buffer.strides[0] == sizeof(T);
+    }
+
+    static const char* component(const char* item, const Py_buffer&, std::size_t) {
+        return item;
+    }
+
+    static void layout(std::size_t size, Py_ssize_t* shape, Py_ssize_t* strides) {
+        shape[0] = size;
+        strides[0] = sizeof(T);
+    }
+};
+
+/* A list of N vectors or matrices taken from any object implementing the
+   buffer protocol, such as a numpy array of shape (N, size) for vectors,
+   (N, rows, cols) for matrices or just (N) for one-component vectors. Float
+   types accept both float and double items, integer types only 32-bit
+   integers. If the memory layout matches the type exactly, the data is used
+   directly, otherwise it's converted to a temporary array. The buffer is held
+   until the instance is destroyed. */
+template<class T> class ArrayInput {
+    public:
+        explicit ArrayInput(py::handle object) {
+            if(PyObject_GetBuffer(object.ptr(), &_buffer, PyBUF_FORMAT|PyBUF_STRIDES) != 0)
+                throw py::error_already_set{};
+
+            if(!init()) {
+                PyBuffer_Release(&_buffer);
+                throw py::error_already_set{};
+            }
+        }
+
+        /* Takes over an already acquired buffer, which is released on
+           destruction or if it doesn't match the type */
+        explicit ArrayInput(const Py_buffer& buffer): _buffer(buffer) {
+            if(!init()) {
+                PyBuffer_Release(&_buffer);
+                throw py::error_already_set{};
+            }
+        }
+
+        ArrayInput(const ArrayInput<T>&) = delete;
+        ArrayInput(ArrayInput<T>&&) = delete;
+        ArrayInput<T>& operator=(const ArrayInput<T>&) = delete;
+        ArrayInput<T>& operator=(ArrayInput<T>&&) = delete;
+
+        ~ArrayInput() { PyBuffer_Release(&_buffer); }
+
+        std::size_t size() const { return _view.size(); }
+
+        Containers::ArrayView<const T> view() const { return _view; }
+
+        const T& operator[](std::size_t i) const { return _view[i]; }
+
+        /* Whether the buffer memory is used directly, without a copy */
+        bool isView() const { return !_copy.data(); }
+
+    private:
+        typedef typename T::Type Type;
+
+        bool init() {
+            if(_buffer.ndim != ArrayInputTraits<T>::Dimensions) {
+                PyErr_Format(PyExc_BufferError, "expected %i dimensions but got %i", int(ArrayInputTraits<T>::Dimensions), _buffer.ndim);
+                return false;
+            }
+
+            if(!ArrayInputTraits<T>::checkShape(_buffer)) return false;
+
+            /* Expecting just an one-letter format */
+            const char format = _buffer.format[1] ? '\0' : _buffer.format[0];
+            if(!ArrayInputFormat<Type>::accepts(format)) {
+                PyErr_Format(PyExc_BufferError, "expected format %s but got %s", ArrayInputFormat<Type>::name(), _buffer.format);
+                return false;
+            }
+
+            const std::size_t size = _buffer.shape[0];
+            if(format == ArrayInputFormat<Type>::Native && ArrayInputTraits<T>::isContiguous(_buffer)) {
+                _view = {static_cast<const T*>(_buffer.buf), size};
+                return true;
+            }
+
+            _copy = Containers::Array<T>{Containers::NoInit, size};
+            for(std::size_t i = 0; i != size; ++i) {
+                const char* item = static_cast<const char*>(_buffer.buf) + i*_buffer.strides[0];
+                Type* out = _copy[i].data();
+                for(std::size_t j = 0; j != sizeof(T)/sizeof(Type); ++j) {
+                    const char* component = ArrayInputTraits<T>::component(item, _buffer, j);
+                    if(format == 'f')
+                        out[j] = Type(*reinterpret_cast<const Float*>(component));
+                    else if(format == 'd')
+                        out[j] = Type(*reinterpret_cast<const Double*>(component));
+                    else
+                        out[j] = *reinterpret_cast<const Type*>(component);
+                }
+            }
+            _view = _copy;
+            return true;
+        }
+
+        /* GCC 4.8 otherwise loudly complains about missing initializers */
+        Py_buffer _buffer{nullptr, nullptr, 0, 0, 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr};
+        Containers::Array<T> _copy;
+        Containers::ArrayView<const T> _view;
+};
+
+/* Storage for arrays returned from arrayOutput(), exposed through the buffer
+   protocol in the memory layout of the original type */
+struct ArrayOutput {
+    /* Either the data are owned by the instance or by the owner object, such
+       as a memoryview on a bytearray */
+    Containers::Array<char> data;
+    py::object owner;
+    char* pointer;
+    std::size_t size;
+    char format[2];
+    int ndim;
+    Py_ssize_t itemsize;
+    Py_ssize_t shape[3];
+    Py_ssize_t strides[3];
+};
+
+inline bool arrayOutputBufferProtocol(ArrayOutput& self, Py_buffer& buffer, int flags) {
+    /* Matrices are column-major, so the rows first shape is neither C- nor
+       Fortran-contiguous and can't be described without strides */
+    if(self.ndim == 3 && ((flags & PyBUF_STRIDES) != PyBUF_STRIDES ||
+       (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS ||
+       (flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS ||
+       (flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS)) {
+        PyErr_SetString(PyExc_BufferError, "matrix arrays are not contiguous");
+        return false;
+    }
+
+    buffer.ndim = self.ndim;
+    buffer.itemsize = self.itemsize;
+    buffer.len = self.size;
+    buffer.buf = self.pointer;
+    buffer.readonly = false;
+    if((flags & PyBUF_FORMAT) == PyBUF_FORMAT)
+        buffer.format = self.format;
+    if(flags != PyBUF_SIMPLE) {
+        buffer.shape = self.shape;
+        if((flags & PyBUF_STRIDES) == PyBUF_STRIDES)
+            buffer.strides = self.strides;
+    }
+
+    return true;
+}
+
+/* Needs to be called by each module using arrayOutput() */
+inline void arrayOutputType(py::module& m) {
+    py::class_<ArrayOutput> c{m, "ArrayOutput", "Array of vectors or matrices", py::buffer_protocol{}};
+    corrade::enableBetterBufferProtocol<ArrayOutput, arrayOutputBufferProtocol>(c);
+}
+
+/* Fills in the layout for given type and wraps the storage in a memoryview,
+   used by arrayOutput() and arrayOutputView() below */
+template<class T> py::object arrayOutputMemoryView(ArrayOutput&& out, std::size_t size) {
+    typedef typename T::Type Type;
+    out.format[0] = ArrayInputFormat<Type>::Native;
+    out.format[1] = '\0';
+    out.ndim = ArrayInputTraits<T>::Dimensions;
+    out.itemsize = sizeof(Type);
+    ArrayInputTraits<T>::layout(size, out.shape, out.strides);
+
+    py::object view = py::reinterpret_steal<py::object>(PyMemoryView_FromObject(py::cast(std::move(out)).ptr()));
+    if(!view) throw py::error_already_set{};
+    return view;
+}
+
+/* The other direction, a list of N vectors or matrices copied as-is and
+   returned as a memoryview of the same shape and memory layout ArrayInput
+   uses without a copy, so the result can be passed back to it directly.
+   Matrices are thus (N, rows, cols) with column-major strides. The
+   memoryview owns the data, so numpy can use it without another copy. */
+template<class T> py::object arrayOutput(Containers::ArrayView<const T> data) {
+    ArrayOutput out;
+    out.data = Containers::Array<char>{Containers::NoInit, data.size()*sizeof(T)};
+    if(!data.empty()) std::memcpy(out.data.data(), data.data(), out.data.size());
+    out.pointer = out.data.data();
+    out.size = out.data.size();
+    return arrayOutputMemoryView<T>(std::move(out), data.size());
+}
+
+/* Same as arrayOutput(), but a writable view on a bytearray containing N
+   items of given type instead of a copy. The view holds a buffer export of
+   the bytearray, so Python doesn't allow it to be resized while the view
+   exists. */
+template<class T> py::object arrayOutputView(py::handle bytearray) {
+    ArrayOutput out;
+    out.owner = py::reinterpret_steal<py::object>(PyMemoryView_FromObject(bytearray.ptr()));
+    if(!out.owner) throw py::error_already_set{};
+    out.pointer = PyByteArray_AS_STRING(bytearray.ptr());
+    out.size = PyByteArray_GET_SIZE(bytearray.ptr());
+    const std::size_t size = out.size/sizeof(T);
+    return arrayOutputMemoryView<T>(std::move(out), size);
+}
+
+}
+
+#endif
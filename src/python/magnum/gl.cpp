@@ -25,29 +25,72 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h> /* for Mesh.buffers */
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/MurmurHash2.h>
 #include <Magnum/Image.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/GL/AbstractShaderProgram.h>
 #include <Magnum/GL/Attribute.h>
 #include <Magnum/GL/Buffer.h>
+#ifndef MAGNUM_TARGET_GLES2
+#include <Magnum/GL/BufferImage.h>
+#endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <Magnum/GL/BufferTexture.h>
+#include <Magnum/GL/BufferTextureFormat.h>
+#endif
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/CubeMapTexture.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Framebuffer.h>
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <Magnum/GL/ImageFormat.h>
+#endif
 #include <Magnum/GL/Mesh.h>
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <Magnum/GL/MultisampleTexture.h>
+#endif
+#include <Magnum/GL/PixelFormat.h>
+#ifndef MAGNUM_TARGET_GLES2
+#include <Magnum/GL/PrimitiveQuery.h>
+#endif
 #include <Magnum/GL/Renderer.h>
 #include <Magnum/GL/Renderbuffer.h>
 #include <Magnum/GL/RenderbufferFormat.h>
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include <Magnum/GL/SampleQuery.h>
+#endif
 #include <Magnum/GL/Shader.h>
 #include <Magnum/GL/TextureFormat.h>
 #include <Magnum/GL/Texture.h>
+#ifndef MAGNUM_TARGET_GLES2
+#include <Magnum/GL/TextureArray.h>
+#endif
+#include <Magnum/GL/TimeQuery.h>
+#ifndef MAGNUM_TARGET_GLES2
+#include <Magnum/GL/TransformFeedback.h>
+#endif
 #include <Magnum/GL/Version.h>
 #include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix3.h>
+#include <Magnum/Math/Matrix4.h>
 
 #include "Corrade/Python.h"
+#include "Corrade/Containers/Python.h"
 #include "Magnum/Python.h"
 #include "Magnum/GL/Python.h"
 
 #include "corrade/EnumOperators.h"
+#include "magnum/arrayinput.h"
 #include "magnum/bootstrap.h"
 
 namespace magnum { namespace {
@@ -98,19 +141,190 @@ template<class T> void setUniform(GL::AbstractShaderProgram& self, Int location,
     static_cast<PublicizedAbstractShaderProgram&>(self).setUniform(location, value);
 }
 
-template<UnsignedInt dimensions> void texture(py::class_<GL::Texture<dimensions>, GL::AbstractTexture>& c) {
+/* Uniform array upload from a buffer. The uniform type is picked based on
+   buffer shape and format by setUniformArray() below, the actual validation
+   and conversion is then done by ArrayInput. */
+typedef void(*SetUniformArray)(GL::AbstractShaderProgram&, Int, const Py_buffer&);
+
+template<class T> void setUniformArrayImplementation(GL::AbstractShaderProgram& self, Int location, const Py_buffer& buffer) {
+    ArrayInput<T> input{buffer};
+    static_cast<PublicizedAbstractShaderProgram&>(self).setUniform(location, input.view());
+}
+
+template<class T> void setUniformArrayScalar(GL::AbstractShaderProgram& self, Int location, const Py_buffer& buffer) {
+    ArrayInput<Math::Vector<1, T>> input{buffer};
+    static_cast<PublicizedAbstractShaderProgram&>(self).setUniform(location, Containers::arrayCast<const T>(input.view()));
+}
+
+template<class T> SetUniformArray setUniformArrayVector(const Py_ssize_t size) {
+    switch(size) {
+        case 2: return setUniformArrayImplementation<Math::Vector<2, T>>;
+        case 3: return setUniformArrayImplementation<Math::Vector<3, T>>;
+        case 4: return setUniformArrayImplementation<Math::Vector<4, T>>;
+    }
+
+    return nullptr;
+}
+
+template<class T> SetUniformArray setUniformArrayMatrix(const Py_ssize_t cols, const Py_ssize_t rows) {
+    if(cols == 2 && rows == 2) return setUniformArrayImplementation<Math::RectangularMatrix<2, 2, T>>;
+    if(cols == 3 && rows == 3) return setUniformArrayImplementation<Math::RectangularMatrix<3, 3, T>>;
+    if(cols == 4 && rows == 4) return setUniformArrayImplementation<Math::RectangularMatrix<4, 4, T>>;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(cols == 2 && rows == 3) return setUniformArrayImplementation<Math::RectangularMatrix<2, 3, T>>;
+    if(cols == 3 && rows == 2) return setUniformArrayImplementation<Math::RectangularMatrix<3, 2, T>>;
+    if(cols == 2 && rows == 4) return setUniformArrayImplementation<Math::RectangularMatrix<2, 4, T>>;
+    if(cols == 4 && rows == 2) return setUniformArrayImplementation<Math::RectangularMatrix<4, 2, T>>;
+    if(cols == 3 && rows == 4) return setUniformArrayImplementation<Math::RectangularMatrix<3, 4, T>>;
+    if(cols == 4 && rows == 3) return setUniformArrayImplementation<Math::RectangularMatrix<4, 3, T>>;
+    #endif
+
+    return nullptr;
+}
+
+void setUniformArray(GL::AbstractShaderProgram& self, const Int location, py::handle values) {
+    /* GCC 4.8 otherwise loudly complains about missing initializers */
+    Py_buffer buffer{nullptr, nullptr, 0, 0, 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr};
+    if(PyObject_GetBuffer(values.ptr(), &buffer, PyBUF_FORMAT|PyBUF_STRIDES) != 0)
+        throw py::error_already_set{};
+
+    /* Scalars are (N), vectors (N, size) and matrices (N, rows, cols) */
+    const char format = buffer.format[1] ? '\0' : buffer.format[0];
+    SetUniformArray set = nullptr;
+    if(buffer.ndim == 1) {
+        if(format == 'f') set = setUniformArrayScalar<Float>;
+        else if(format == 'i') set = setUniformArrayScalar<Int>;
+        #ifndef MAGNUM_TARGET_GLES2
+        else if(format == 'I') set = setUniformArrayScalar<UnsignedInt>;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        else if(format == 'd') set = setUniformArrayScalar<Double>;
+        #endif
+    } else if(buffer.ndim == 2) {
+        if(format == 'f') set = setUniformArrayVector<Float>(buffer.shape[1]);
+        else if(format == 'i') set = setUniformArrayVector<Int>(buffer.shape[1]);
+        #ifndef MAGNUM_TARGET_GLES2
+        else if(format == 'I') set = setUniformArrayVector<UnsignedInt>(buffer.shape[1]);
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        else if(format == 'd') set = setUniformArrayVector<Double>(buffer.shape[1]);
+        #endif
+    } else if(buffer.ndim == 3) {
+        if(format == 'f') set = setUniformArrayMatrix<Float>(buffer.shape[2], buffer.shape[1]);
+        #ifndef MAGNUM_TARGET_GLES
+        else if(format == 'd') set = setUniformArrayMatrix<Double>(buffer.shape[2], buffer.shape[1]);
+        #endif
+    }
+
+    if(!set) {
+        std::string shape;
+        for(int i = 0; i != buffer.ndim; ++i) {
+            if(i) shape += ", ";
+            shape += std::to_string(buffer.shape[i]);
+        }
+        PyErr_Format(PyExc_BufferError, "unsupported uniform array of format %s and shape (%s)", buffer.format, shape.data());
+        PyBuffer_Release(&buffer);
+        throw py::error_already_set{};
+    }
+
+    /* Takes over the buffer ownership */
+    set(self, location, buffer);
+}
+
+/* A setter for a single uniform with the type resolved upfront, avoiding the
+   overload resolution in set_uniform() */
+struct UniformSetter {
+    typedef void(*Function)(GL::AbstractShaderProgram&, Int, py::handle);
+
+    GL::AbstractShaderProgram& program;
+    Int location;
+    Function set;
+};
+
+template<class T> void setUniformFromHandle(GL::AbstractShaderProgram& self, Int location, py::handle value) {
+    static_cast<PublicizedAbstractShaderProgram&>(self).setUniform(location, py::cast<T>(value));
+}
+
+template<class T> std::pair<const std::type_info*, UniformSetter::Function> uniformSetterEntry() {
+    return {&typeid(T), setUniformFromHandle<T>};
+}
+
+UniformSetter::Function uniformSetterFor(py::handle type) {
+    /* Builtin Python types. There's no way to distinguish unsigned integers
+       or doubles. */
+    if(type.ptr() == reinterpret_cast<PyObject*>(&PyFloat_Type))
+        return setUniformFromHandle<Float>;
+    if(type.ptr() == reinterpret_cast<PyObject*>(&PyLong_Type))
+        return setUniformFromHandle<Int>;
+
+    /* Magnum math types */
+    static const std::pair<const std::type_info*, UniformSetter::Function> types[]{
+        uniformSetterEntry<Vector2>(),
+        uniformSetterEntry<Vector3>(),
+        uniformSetterEntry<Vector4>(),
+        uniformSetterEntry<Color3>(),
+        uniformSetterEntry<Color4>(),
+        uniformSetterEntry<Vector2i>(),
+        uniformSetterEntry<Vector3i>(),
+        uniformSetterEntry<Vector4i>(),
+        #ifndef MAGNUM_TARGET_GLES2
+        uniformSetterEntry<Vector2ui>(),
+        uniformSetterEntry<Vector3ui>(),
+        uniformSetterEntry<Vector4ui>(),
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        uniformSetterEntry<Vector2d>(),
+        uniformSetterEntry<Vector3d>(),
+        uniformSetterEntry<Vector4d>(),
+        #endif
+        uniformSetterEntry<Matrix2x2>(),
+        uniformSetterEntry<Matrix3x3>(),
+        uniformSetterEntry<Matrix4x4>(),
+        uniformSetterEntry<Matrix3>(),
+        uniformSetterEntry<Matrix4>(),
+        #ifndef MAGNUM_TARGET_GLES2
+        uniformSetterEntry<Matrix2x3>(),
+        uniformSetterEntry<Matrix3x2>(),
+        uniformSetterEntry<Matrix2x4>(),
+        uniformSetterEntry<Matrix4x2>(),
+        uniformSetterEntry<Matrix3x4>(),
+        uniformSetterEntry<Matrix4x3>(),
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        uniformSetterEntry<Matrix2x2d>(),
+        uniformSetterEntry<Matrix3x3d>(),
+        uniformSetterEntry<Matrix4x4d>(),
+        uniformSetterEntry<Matrix3d>(),
+        uniformSetterEntry<Matrix4d>(),
+        uniformSetterEntry<Matrix2x3d>(),
+        uniformSetterEntry<Matrix3x2d>(),
+        uniformSetterEntry<Matrix2x4d>(),
+        uniformSetterEntry<Matrix4x2d>(),
+        uniformSetterEntry<Matrix3x4d>(),
+        uniformSetterEntry<Matrix4x3d>(),
+        #endif
+    };
+    for(const auto& entry: types) {
+        py::detail::type_info* const info = py::detail::get_type_info(*entry.first);
+        if(info && type.ptr() == reinterpret_cast<PyObject*>(info->type))
+            return entry.second;
+    }
+
+    return nullptr;
+}
+
+/* Sampler state, common for all texture types except buffer and
+   multisample textures */
+template<class T> void sampler(py::class_<T, GL::AbstractTexture>& c) {
     c
-        /** @todo limits */
-        .def(py::init(), "Constructor")
-        /** @todo bindImage(), bindImageLayered */
         #ifndef MAGNUM_TARGET_GLES2
-        .def_property("base_level", nullptr, &GL::Texture<dimensions>::setBaseLevel, "Base mip level")
+        .def_property("base_level", nullptr, &T::setBaseLevel, "Base mip level")
         #endif
         #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
-        .def_property("max_level", nullptr, &GL::Texture<dimensions>::setMaxLevel, "Max mip level")
+        .def_property("max_level", nullptr, &T::setMaxLevel, "Max mip level")
         #endif
         .def_property("minification_filter", nullptr,
-            [](GL::Texture<dimensions>& self, py::object value) {
+            [](T& self, py::object value) {
                 if(py::isinstance<SamplerFilter>(value))
                     self.setMinificationFilter(py::cast<SamplerFilter>(value));
                 else if(py::isinstance<GL::SamplerFilter>(value))
@@ -145,7 +359,7 @@ template<UnsignedInt dimensions> void texture(py::class_<GL::Texture<dimensions>
                 }
             }, "Minification filter")
         .def_property("magnification_filter", nullptr,
-            [](GL::Texture<dimensions>& self, py::object filter) {
+            [](T& self, py::object filter) {
                 if(py::isinstance<SamplerFilter>(filter))
                     self.setMagnificationFilter(py::cast<SamplerFilter>(filter));
                 else if(py::isinstance<GL::SamplerFilter>(filter))
@@ -156,14 +370,14 @@ template<UnsignedInt dimensions> void texture(py::class_<GL::Texture<dimensions>
                 }
             }, "Magnification filter")
         #ifndef MAGNUM_TARGET_GLES2
-        .def_property("min_lod", nullptr, &GL::Texture<dimensions>::setMinLod, "Minimum level-of-detail")
-        .def_property("max_lod", nullptr, &GL::Texture<dimensions>::setMaxLod, "Maximum level-of-detail")
+        .def_property("min_lod", nullptr, &T::setMinLod, "Minimum level-of-detail")
+        .def_property("max_lod", nullptr, &T::setMaxLod, "Maximum level-of-detail")
         #endif
         #ifndef MAGNUM_TARGET_GLES
-        .def_property("lod_bias", nullptr, &GL::Texture<dimensions>::setLodBias, "Level-of-detail bias")
+        .def_property("lod_bias", nullptr, &T::setLodBias, "Level-of-detail bias")
         #endif
         .def_property("wrapping", nullptr,
-            [](GL::Texture<dimensions>& self, py::object wrapping) {
+            [](T& self, py::object wrapping) {
                 /** @todo accept two/three different values as well */
                 if(py::isinstance<SamplerWrapping>(wrapping))
                     self.setWrapping(py::cast<SamplerWrapping>(wrapping));
@@ -177,9 +391,9 @@ template<UnsignedInt dimensions> void texture(py::class_<GL::Texture<dimensions>
         #ifndef MAGNUM_TARGET_WEBGL
         .def_property("border_color", nullptr,
             #ifdef MAGNUM_TARGET_GLES2
-            &GL::Texture<dimensions>::setBorderColor,
+            &T::setBorderColor,
             #else
-            [](GL::Texture<dimensions>& self, py::object color) {
+            [](T& self, py::object color) {
                 if(py::isinstance<Vector3>(color))
                     self.setBorderColor(py::cast<Vector3>(color));
                 else if(py::isinstance<Vector4>(color))
@@ -196,18 +410,28 @@ template<UnsignedInt dimensions> void texture(py::class_<GL::Texture<dimensions>
             #endif
             "Border color")
         #endif
-        .def_property("max_anisotropy", nullptr, &GL::Texture<dimensions>::setMaxAnisotropy, "Max anisotropy")
+        .def_property("max_anisotropy", nullptr, &T::setMaxAnisotropy, "Max anisotropy")
         #ifndef MAGNUM_TARGET_WEBGL
-        .def_property("srgb_decode", nullptr, &GL::Texture<dimensions>::setSrgbDecode, "sRGB decoding")
+        .def_property("srgb_decode", nullptr, &T::setSrgbDecode, "sRGB decoding")
         #endif
         /** @todo component swizzle (it's compile-time on C++ side, ugh) */
         #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
-        .def_property("compare_mode", nullptr, &GL::Texture<dimensions>::setCompareMode, "Depth texture comparison mode")
-        .def_property("compare_function", nullptr, &GL::Texture<dimensions>::setCompareFunction, "Depth texture comparison function")
+        .def_property("compare_mode", nullptr, &T::setCompareMode, "Depth texture comparison mode")
+        .def_property("compare_function", nullptr, &T::setCompareFunction, "Depth texture comparison function")
         #endif
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-        .def_property("depth_stencil_mode", nullptr, &GL::Texture<dimensions>::setDepthStencilMode, "Depth/stencil texture mode")
+        .def_property("depth_stencil_mode", nullptr, &T::setDepthStencilMode, "Depth/stencil texture mode")
         #endif
+        ;
+}
+
+template<UnsignedInt dimensions> void texture(py::class_<GL::Texture<dimensions>, GL::AbstractTexture>& c) {
+    sampler(c);
+
+    c
+        /** @todo limits */
+        .def(py::init(), "Constructor")
+        /* bindImage() is different for 3D textures, bound separately */
         /* Using a lambda to avoid method chaining leaking to Python */
         .def("set_storage", [](GL::Texture<dimensions>& self, Int levels, GL::TextureFormat internalFormat, const typename PyDimensionTraits<dimensions, Int>::VectorType& size) {
             self.setStorage(levels, internalFormat, size);
@@ -222,11 +446,21 @@ template<UnsignedInt dimensions> void texture(py::class_<GL::Texture<dimensions>
         .def("set_image", [](GL::Texture<dimensions>& self, Int level, GL::TextureFormat internalFormat, const BasicImageView<dimensions>& image) {
             self.setImage(level, internalFormat, image);
         }, "Set image data", py::arg("level"), py::arg("internal_format"), py::arg("image"))
-        /** @todo compressed/buffer setImage() */
+        #ifndef MAGNUM_TARGET_GLES2
+        .def("set_image", [](GL::Texture<dimensions>& self, Int level, GL::TextureFormat internalFormat, GL::BufferImage<dimensions>& image) {
+            self.setImage(level, internalFormat, image);
+        }, "Set image data from a buffer", py::arg("level"), py::arg("internal_format"), py::arg("image"))
+        #endif
+        /** @todo compressed setImage() */
         .def("set_sub_image", [](GL::Texture<dimensions>& self, Int level, const typename PyDimensionTraits<dimensions, Int>::VectorType& offset, const BasicImageView<dimensions>& image) {
             self.setSubImage(level, offset, image);
         }, "Set image subdata", py::arg("level"), py::arg("offset"), py::arg("image"))
-        /** @todo compressed/buffer setSubImage() */
+        #ifndef MAGNUM_TARGET_GLES2
+        .def("set_sub_image", [](GL::Texture<dimensions>& self, Int level, const typename PyDimensionTraits<dimensions, Int>::VectorType& offset, GL::BufferImage<dimensions>& image) {
+            self.setSubImage(level, offset, image);
+        }, "Set image subdata from a buffer", py::arg("level"), py::arg("offset"), py::arg("image"))
+        #endif
+        /** @todo compressed setSubImage() */
         .def("generate_mipmap", [](GL::Texture<dimensions>& self) {
             self.generateMipmap();
         }, "Generate mipmap")
@@ -236,6 +470,472 @@ template<UnsignedInt dimensions> void texture(py::class_<GL::Texture<dimensions>
         }, "Invalidate texture subimage", py::arg("level"), py::arg("offset"), py::arg("size"));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void textureArray(py::class_<GL::TextureArray<dimensions>, GL::AbstractTexture>& c) {
+    sampler(c);
+
+    c
+        /** @todo limits */
+        .def(py::init(), "Constructor")
+        /* bindImage() is different for 1D arrays, bound separately */
+        /* Using a lambda to avoid method chaining leaking to Python */
+        .def("set_storage", [](GL::TextureArray<dimensions>& self, Int levels, GL::TextureFormat internalFormat, const typename PyDimensionTraits<dimensions + 1, Int>::VectorType& size) {
+            self.setStorage(levels, internalFormat, size);
+        }, "Set storage", py::arg("levels"), py::arg("internal_format"), py::arg("size"))
+        #ifndef MAGNUM_TARGET_WEBGL
+        .def("image_size", [](GL::TextureArray<dimensions>& self, Int level) {
+            return PyDimensionTraits<dimensions + 1, Int>::from(self.imageSize(level));
+        }, "Image size in given mip level", py::arg("level"))
+        #endif
+        /** @todo (compressed/buffer) (sub)image queries */
+        /* Using a lambda to avoid method chaining leaking to Python */
+        .def("set_image", [](GL::TextureArray<dimensions>& self, Int level, GL::TextureFormat internalFormat, const BasicImageView<dimensions + 1>& image) {
+            self.setImage(level, internalFormat, image);
+        }, "Set image data", py::arg("level"), py::arg("internal_format"), py::arg("image"))
+        .def("set_image", [](GL::TextureArray<dimensions>& self, Int level, GL::TextureFormat internalFormat, GL::BufferImage<dimensions + 1>& image) {
+            self.setImage(level, internalFormat, image);
+        }, "Set image data from a buffer", py::arg("level"), py::arg("internal_format"), py::arg("image"))
+        /** @todo compressed setImage() */
+        .def("set_sub_image", [](GL::TextureArray<dimensions>& self, Int level, const typename PyDimensionTraits<dimensions + 1, Int>::VectorType& offset, const BasicImageView<dimensions + 1>& image) {
+            self.setSubImage(level, offset, image);
+        }, "Set image subdata", py::arg("level"), py::arg("offset"), py::arg("image"))
+        .def("set_sub_image", [](GL::TextureArray<dimensions>& self, Int level, const typename PyDimensionTraits<dimensions + 1, Int>::VectorType& offset, GL::BufferImage<dimensions + 1>& image) {
+            self.setSubImage(level, offset, image);
+        }, "Set image subdata from a buffer", py::arg("level"), py::arg("offset"), py::arg("image"))
+        /** @todo compressed setSubImage() */
+        .def("generate_mipmap", [](GL::TextureArray<dimensions>& self) {
+            self.generateMipmap();
+        }, "Generate mipmap")
+        .def("invalidate_image", &GL::TextureArray<dimensions>::invalidateImage, "Invalidate texture image", py::arg("level"))
+        .def("invalidate_sub_image", [](GL::TextureArray<dimensions>& self, Int level, const typename PyDimensionTraits<dimensions + 1, Int>::VectorType& offset, const typename PyDimensionTraits<dimensions + 1, Int>::VectorType& size) {
+            self.invalidateSubImage(level, offset, size);
+        }, "Invalidate texture subimage", py::arg("level"), py::arg("offset"), py::arg("size"));
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void bufferImage(py::class_<GL::BufferImage<dimensions>>& c) {
+    c
+        /** @todo constructors taking data, GL-specific formats */
+        .def(py::init<PixelStorage, PixelFormat>(), "Construct an image placeholder", py::arg("storage"), py::arg("format"))
+        .def(py::init<PixelFormat>(), "Construct an image placeholder", py::arg("format"))
+        /* Using a lambda to avoid method chaining leaking to Python */
+        .def("set_data", [](GL::BufferImage<dimensions>& self, const PixelStorage& storage, PixelFormat format, const typename PyDimensionTraits<dimensions, Int>::VectorType& size, const Containers::ArrayView<const char>& data, GL::BufferUsage usage) {
+            self.setData(storage, format, size, data, usage);
+        }, "Set image data", py::arg("storage"), py::arg("format"), py::arg("size"), py::arg("data"), py::arg("usage"))
+        .def("set_data", [](GL::BufferImage<dimensions>& self, PixelFormat format, const typename PyDimensionTraits<dimensions, Int>::VectorType& size, const Containers::ArrayView<const char>& data, GL::BufferUsage usage) {
+            self.setData(format, size, data, usage);
+        }, "Set image data", py::arg("format"), py::arg("size"), py::arg("data"), py::arg("usage"))
+        .def_property_readonly("storage", &GL::BufferImage<dimensions>::storage, "Storage of pixel data")
+        .def_property_readonly("pixel_size", &GL::BufferImage<dimensions>::pixelSize, "Pixel size (in bytes)")
+        .def_property_readonly("size", [](GL::BufferImage<dimensions>& self) {
+            return PyDimensionTraits<dimensions, Int>::from(self.size());
+        }, "Image size")
+        .def_property_readonly("data_size", &GL::BufferImage<dimensions>::dataSize, "Image data size")
+        .def_property_readonly("buffer", static_cast<GL::Buffer&(GL::BufferImage<dimensions>::*)()>(&GL::BufferImage<dimensions>::buffer), "Image buffer", py::return_value_policy::reference_internal);
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+/* Generic pixel format corresponding to given GL format and type, if any.
+   Several generic formats can map to the same GL format (e.g. the sRGB and
+   non-sRGB variants), the first one is picked in that case. */
+bool genericPixelFormat(const GL::PixelFormat format, const GL::PixelType type, PixelFormat& out) {
+    for(UnsignedInt i = UnsignedInt(PixelFormat::R8Unorm); i <= UnsignedInt(PixelFormat::RGBA32F); ++i) {
+        const PixelFormat generic = PixelFormat(i);
+        if(!GL::hasPixelFormat(generic)) continue;
+        if(GL::pixelFormat(generic) == format && GL::pixelType(generic) == type) {
+            out = generic;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Pending readback into a pixel pack buffer, guarded by a fence. Magnum
+   doesn't have a sync object wrapper, so it's done on the raw GL API. */
+struct AsyncReadback {
+    explicit AsyncReadback(py::object image): image{std::move(image)}, fence{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)} {}
+
+    AsyncReadback(const AsyncReadback&) = delete;
+    AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+    ~AsyncReadback() {
+        if(fence) glDeleteSync(fence);
+        if(mapped) py::cast<GL::BufferImage2D&>(image).buffer().unmap();
+    }
+
+    GL::BufferImage2D& bufferImage() { return py::cast<GL::BufferImage2D&>(image); }
+
+    /* Polls the fence without blocking, the first poll flushes the command
+       stream so the fence is guaranteed to be signaled eventually */
+    bool ready() {
+        if(!fence) return true;
+        const GLenum status = glClientWaitSync(fence, flushed ? 0 : GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        flushed = true;
+        if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            return false;
+        glDeleteSync(fence);
+        fence = nullptr;
+        return true;
+    }
+
+    bool wait(const GLuint64 timeout) {
+        if(!fence) return true;
+        GLenum status;
+        {
+            /* Other Python threads can continue while we're waiting */
+            py::gil_scoped_release release;
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        }
+        flushed = true;
+        if(status == GL_WAIT_FAILED) {
+            PyErr_SetString(PyExc_RuntimeError, "waiting for the fence failed");
+            throw py::error_already_set{};
+        }
+        if(status == GL_TIMEOUT_EXPIRED) return false;
+        glDeleteSync(fence);
+        fence = nullptr;
+        return true;
+    }
+
+    py::object image;
+    GLsync fence;
+    bool flushed{}, mapped{};
+};
+#endif
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+/* Resolves given multisample framebuffer region into a single-sample
+   framebuffer that's cached in the framebuffer holder, so the resolve doesn't
+   need to recreate the GL objects every time */
+GL::Framebuffer& resolveFramebuffer(GL::Framebuffer& self, const Range2Di& rectangle, GL::RenderbufferFormat format) {
+    GL::PyFramebufferHolder<GL::Framebuffer>& holder = pyObjectHolderFor<GL::PyFramebufferHolder>(self);
+    if(!holder.resolve || holder.resolveFormat != UnsignedInt(format) || py::cast<GL::Framebuffer&>(holder.resolve).viewport().size() != rectangle.size()) {
+        GL::Renderbuffer* renderbuffer = new GL::Renderbuffer;
+        py::object renderbufferObject = py::cast(renderbuffer, py::return_value_policy::take_ownership);
+        renderbuffer->setStorage(format, rectangle.size());
+
+        GL::Framebuffer* framebuffer = new GL::Framebuffer{Range2Di{{}, rectangle.size()}};
+        py::object framebufferObject = py::cast(framebuffer, py::return_value_policy::take_ownership);
+        framebuffer->attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, *renderbuffer);
+        pyObjectHolderFor<GL::PyFramebufferHolder>(*framebuffer).attachments.push_back(std::move(renderbufferObject));
+
+        holder.resolve = std::move(framebufferObject);
+        holder.resolveFormat = UnsignedInt(format);
+    }
+
+    GL::Framebuffer& resolve = py::cast<GL::Framebuffer&>(holder.resolve);
+    GL::AbstractFramebuffer::blit(self, resolve, rectangle, {{}, rectangle.size()}, GL::FramebufferBlit::Color, GL::FramebufferBlitFilter::Nearest);
+    return resolve;
+}
+#endif
+
+/* Asynchronous shader compilation and program linking. Magnum's compile()
+   and link() check the status right after submitting the work, which makes
+   the driver wait for it to finish, so the submission is done on the raw GL
+   API and the status is checked separately. With KHR_parallel_shader_compile
+   the completion can be polled without blocking, otherwise the work is still
+   deferred until the status is checked. Programs are tracked by ID as there's
+   no place for extra state in the Magnum classes, a draw with a program that
+   wasn't checked yet checks it first. Both the tracked IDs and the extension
+   support are global, not per GL context, so programs linked asynchronously
+   in one context shouldn't be drawn from another that doesn't share objects
+   with it. */
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+std::unordered_set<GLuint> pendingLinks;
+
+bool parallelShaderCompile() {
+    static const bool supported = [] {
+        for(const std::string& extension: GL::Context::current().extensionStrings())
+            if(extension == "GL_KHR_parallel_shader_compile" || extension == "GL_ARB_parallel_shader_compile")
+                return true;
+        return false;
+    }();
+    return supported;
+}
+
+void compileAsync(GL::Shader& shader) {
+    std::vector<const GLchar*> pointers;
+    std::vector<GLint> sizes;
+    for(const std::string& source: shader.sources()) {
+        pointers.push_back(source.data());
+        sizes.push_back(source.size());
+    }
+
+    glShaderSource(shader.id(), pointers.size(), pointers.data(), sizes.data());
+    glCompileShader(shader.id());
+}
+
+void checkCompile(GL::Shader& shader) {
+    GLint status;
+    glGetShaderiv(shader.id(), GL_COMPILE_STATUS, &status);
+    if(status == GL_TRUE) return;
+
+    GLint logLength;
+    glGetShaderiv(shader.id(), GL_INFO_LOG_LENGTH, &logLength);
+    std::string log(std::max(logLength, 1), '\0');
+    glGetShaderInfoLog(shader.id(), log.size(), nullptr, &log[0]);
+    log.resize(std::max(logLength, 1) - 1);
+    Error{} << "GL::Shader::compile(): compilation failed with the following message:" << Debug::newline << log;
+
+    PyErr_SetString(PyExc_RuntimeError, "compilation failed");
+    throw py::error_already_set{};
+}
+
+void linkAsync(GL::AbstractShaderProgram& program) {
+    glLinkProgram(program.id());
+    const GLuint id = program.id();
+    if(!pendingLinks.insert(id).second) return;
+
+    /* The ID could get reused by another program once this one is destroyed,
+       so erase it on destruction. That's done with a weak reference on the
+       Python instance in order to handle the builtin shaders as well as
+       subclasses created from Python, same as py::keep_alive does it. */
+    py::object instance = py::cast(&program, py::return_value_policy::reference);
+    py::weakref{instance, py::cpp_function([id](py::handle weakref) {
+        pendingLinks.erase(id);
+        weakref.dec_ref();
+    })}.release();
+}
+
+void checkLink(GL::AbstractShaderProgram& program) {
+    pendingLinks.erase(program.id());
+
+    GLint status;
+    glGetProgramiv(program.id(), GL_LINK_STATUS, &status);
+    if(status == GL_TRUE) return;
+
+    GLint logLength;
+    glGetProgramiv(program.id(), GL_INFO_LOG_LENGTH, &logLength);
+    std::string log(std::max(logLength, 1), '\0');
+    glGetProgramInfoLog(program.id(), log.size(), nullptr, &log[0]);
+    log.resize(std::max(logLength, 1) - 1);
+    Error{} << "GL::AbstractShaderProgram::link(): linking failed with the following message:" << Debug::newline << log;
+
+    PyErr_SetString(PyExc_RuntimeError, "linking failed");
+    throw py::error_already_set{};
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/* On-disk cache of linked program binaries. Magnum has just the
+   setRetrievableBinary() switch but no API for getting or setting the binary
+   itself, so it's done on the raw GL API. The cache identity is the driver
+   identification together with the user-supplied key, so a driver update
+   invalidates the cache. The file name is a hash of the identity and the file
+   contains the identity size and the identity itself, followed by the binary
+   format and the binary data. The stored identity is compared on load so a
+   hash collision is a cache miss and not a wrong program. */
+struct ProgramBinaryCache {
+    explicit ProgramBinaryCache(std::string directory): directory{std::move(directory)} {}
+
+    static std::string identity(const std::string& key) {
+        GL::Context& context = GL::Context::current();
+        std::string out;
+        out += context.vendorString();
+        out += '\0';
+        out += context.rendererString();
+        out += '\0';
+        out += context.versionString();
+        out += '\0';
+        out += key;
+        return out;
+    }
+
+    std::string filename(const std::string& identity) const {
+        return Utility::Directory::join(directory, Utility::MurmurHash2{}(identity).hexString() + ".bin");
+    }
+
+    bool load(GL::AbstractShaderProgram& program, const std::string& key) const {
+        const std::string id = identity(key);
+        const std::string file = filename(id);
+        if(!Utility::Directory::exists(file)) return false;
+
+        const Containers::Array<char> data = Utility::Directory::read(file);
+        const std::size_t headerSize = sizeof(UnsignedInt) + id.size() + sizeof(GLenum);
+        if(data.size() <= headerSize) return false;
+
+        UnsignedInt idSize;
+        std::memcpy(&idSize, data, sizeof(UnsignedInt));
+        if(idSize != id.size() || std::memcmp(data + sizeof(UnsignedInt), id.data(), id.size()) != 0)
+            return false;
+
+        GLenum format;
+        std::memcpy(&format, data + headerSize - sizeof(GLenum), sizeof(GLenum));
+        glProgramBinary(program.id(), format, data + headerSize, data.size() - headerSize);
+
+        /* A binary from an incompatible driver is rejected with the program
+           left unlinked, in which case the user is expected to compile and
+           link it again */
+        GLint status;
+        glGetProgramiv(program.id(), GL_LINK_STATUS, &status);
+        return status == GL_TRUE;
+    }
+
+    void save(GL::AbstractShaderProgram& program, const std::string& key) const {
+        GLint size{};
+        glGetProgramiv(program.id(), GL_PROGRAM_BINARY_LENGTH, &size);
+        if(!size) {
+            PyErr_SetString(PyExc_RuntimeError, "the program binary can't be retrieved");
+            throw py::error_already_set{};
+        }
+
+        const std::string id = identity(key);
+        const UnsignedInt idSize = id.size();
+        const std::size_t headerSize = sizeof(UnsignedInt) + id.size() + sizeof(GLenum);
+        Containers::Array<char> data{Containers::NoInit, headerSize + std::size_t(size)};
+        GLenum format;
+        glGetProgramBinary(program.id(), size, nullptr, &format, data + headerSize);
+        std::memcpy(data, &idSize, sizeof(UnsignedInt));
+        std::memcpy(data + sizeof(UnsignedInt), id.data(), id.size());
+        std::memcpy(data + headerSize - sizeof(GLenum), &format, sizeof(GLenum));
+
+        const std::string file = filename(id);
+        if(!Utility::Directory::mkpath(directory) || !Utility::Directory::write(file, data)) {
+            PyErr_Format(PyExc_IOError, "can't write %s", file.data());
+            throw py::error_already_set{};
+        }
+    }
+
+    std::string directory;
+};
+#endif
+
+/* Opt-in renderer statistics. Magnum's own state tracker isn't accessible
+   from outside, so only what goes through the Python API and the hooks
+   exported to other modules is counted. While enabled, a shadow copy of the
+   renderer feature state and clear color is kept to skip redundant calls --
+   it assumes nothing else changes the state behind its back and gets
+   discarded every time the statistics get enabled. The counters are global,
+   the shadow state is kept for each GL context separately. */
+struct RendererState {
+    GLuint currentProgram{};
+    std::unordered_map<GLenum, bool> features;
+    bool hasClearColor{};
+    Color4 clearColor;
+};
+
+struct RendererStatistics {
+    void reset() {
+        drawCalls = programSwitches = textureBinds = bufferBinds =
+            framebufferBinds = stateChanges = redundantStateChanges = 0;
+    }
+
+    /* State of the context current in this thread */
+    RendererState& state() {
+        return states[&GL::Context::current()];
+    }
+
+    bool enabled{};
+    UnsignedLong drawCalls{}, programSwitches{}, textureBinds{}, bufferBinds{},
+        framebufferBinds{}, stateChanges{}, redundantStateChanges{};
+    std::unordered_map<const GL::Context*, RendererState> states;
+} rendererStatistics;
+
+void countProgramUse(GL::AbstractShaderProgram& program) {
+    if(!rendererStatistics.enabled) return;
+    RendererState& state = rendererStatistics.state();
+    if(program.id() != state.currentProgram) {
+        ++rendererStatistics.programSwitches;
+        state.currentProgram = program.id();
+    }
+}
+
+/* Checks a pending asynchronous link and counts the draws. Used by all draws
+   in this module and exported to other modules through PyHooks. */
+void checkLinkAndCountDraws(GL::AbstractShaderProgram& program, std::size_t count) {
+    if(!pendingLinks.empty() && pendingLinks.count(program.id()))
+        checkLink(program);
+    if(!rendererStatistics.enabled || !count) return;
+    rendererStatistics.drawCalls += count;
+    countProgramUse(program);
+}
+
+const GL::PyHooks hooks{
+    checkLinkAndCountDraws,
+    [] { rendererStatistics.states.erase(&GL::Context::current()); }
+};
+
+/* Whether AbstractShaderProgram.draw() releases the GIL, worth it only when
+   threads draw into different contexts in parallel */
+bool releaseGilOnDraw{};
+
+void setFeature(GL::Renderer::Feature feature, bool enabled) {
+    if(rendererStatistics.enabled) {
+        std::unordered_map<GLenum, bool>& features = rendererStatistics.state().features;
+        const auto found = features.find(GLenum(feature));
+        if(found != features.end() && found->second == enabled) {
+            ++rendererStatistics.redundantStateChanges;
+            return;
+        }
+
+        features[GLenum(feature)] = enabled;
+        ++rendererStatistics.stateChanges;
+    }
+
+    GL::Renderer::setFeature(feature, enabled);
+}
+
+/* Ring of time queries measuring GPU time of a section of a frame. The result
+   is retrieved only once available, which is usually a few frames later, so
+   the measurement doesn't stall the pipeline. */
+struct FrameTimer {
+    explicit FrameTimer(UnsignedInt delay): pending(delay) {
+        queries.reserve(delay);
+        for(UnsignedInt i = 0; i != delay; ++i)
+            queries.emplace_back(GL::TimeQuery::Target::TimeElapsed);
+    }
+
+    void begin() {
+        if(running) {
+            PyErr_SetString(PyExc_RuntimeError, "the timer is already running");
+            throw py::error_already_set{};
+        }
+
+        /* All queries in flight, have to wait for the oldest one */
+        if(pending[current]) {
+            duration = queries[current].result<UnsignedLong>()/1.0e6;
+            pending[current] = false;
+        }
+
+        queries[current].begin();
+        running = true;
+    }
+
+    void end() {
+        if(!running) {
+            PyErr_SetString(PyExc_RuntimeError, "the timer is not running");
+            throw py::error_already_set{};
+        }
+
+        queries[current].end();
+        pending[current] = true;
+        current = (current + 1) % queries.size();
+        running = false;
+    }
+
+    /* Retrieves all available results, oldest first, without blocking */
+    void poll() {
+        for(std::size_t i = 0; i != queries.size(); ++i) {
+            const std::size_t index = (current + i) % queries.size();
+            if(!pending[index]) continue;
+            if(!queries[index].resultAvailable()) break;
+            duration = queries[index].result<UnsignedLong>()/1.0e6;
+            pending[index] = false;
+        }
+    }
+
+    std::vector<GL::TimeQuery> queries;
+    std::vector<bool> pending;
+    std::size_t current{};
+    bool running{};
+    Double duration{-1.0};
+};
+
 }
 
 void gl(py::module& m) {
@@ -249,6 +949,9 @@ void gl(py::module& m) {
 
     m.doc() = "OpenGL wrapping layer";
 
+    /* For draws done natively by other modules */
+    m.attr("_hooks") = py::capsule{&hooks};
+
     /* Version and related utilities */
     py::enum_<GL::Version>{m, "Version", "OpenGL version"}
         .value("NONE", GL::Version::None)
@@ -276,7 +979,15 @@ void gl(py::module& m) {
     m
         .def("version", static_cast<GL::Version(*)(Int, Int)>(GL::version), "Enum value from major and minor version number", py::arg("major"), py::arg("minor"))
         .def("version", static_cast<std::pair<Int, Int>(*)(GL::Version)>(GL::version), "Major and minor version number from enum value", py::arg("version"))
-        .def("is_version_es", GL::isVersionES, "Whether given version is OpenGL ES or WebGL");
+        .def("is_version_es", GL::isVersionES, "Whether given version is OpenGL ES or WebGL")
+        .def("is_version_supported", [](GL::Version version) {
+            if(!GL::Context::hasCurrent()) {
+                PyErr_SetString(PyExc_RuntimeError, "no current context");
+                throw py::error_already_set{};
+            }
+
+            return GL::Context::current().isVersionSupported(version);
+        }, "Whether given version is supported by the current context", py::arg("version"));
 
     /* Shader (used by AbstractShaderProgram, so needs to be before) */
     {
@@ -315,12 +1026,34 @@ void gl(py::module& m) {
                     PyErr_SetString(PyExc_RuntimeError, "compilation failed");
                     throw py::error_already_set{};
                 }
-            }, "Compile shader");
+            }, "Compile shader")
+            .def("compile_async", compileAsync, "Submit the shader for compilation without waiting for the result")
+            .def_property_readonly("compile_finished", [](GL::Shader& self) {
+                if(!parallelShaderCompile()) return true;
+                GLint status;
+                glGetShaderiv(self.id(), GL_COMPLETION_STATUS_KHR, &status);
+                return status == GL_TRUE;
+            }, "Whether asynchronous compilation finished")
+            .def("check_compile", checkCompile, "Check result of asynchronous compilation")
+            .def_static("compile_all", [](py::iterable shaders) {
+                for(py::handle shader: shaders)
+                    compileAsync(py::cast<GL::Shader&>(shader));
+            }, "Submit shaders for compilation without waiting for the result", py::arg("shaders"))
+            .def_static("check_compile_all", [](py::iterable shaders) {
+                for(py::handle shader: shaders)
+                    checkCompile(py::cast<GL::Shader&>(shader));
+            }, "Check result of asynchronous compilation of shaders", py::arg("shaders"));
     }
 
     /* Mesh -- needed by AbstractShaderProgram.draw(), so defined earlier */
     py::class_<GL::Mesh, GL::PyMeshHolder<GL::Mesh>> mesh{m, "Mesh", "Mesh"};
 
+    /* Transform feedback -- needed by
+       AbstractShaderProgram.draw_transform_feedback(), so defined earlier */
+    #ifndef MAGNUM_TARGET_GLES2
+    py::class_<GL::TransformFeedback, GL::PyTransformFeedbackHolder<GL::TransformFeedback>> transformFeedback{m, "TransformFeedback", "Transform feedback"};
+    #endif
+
     /* Abstract shader program */
     {
         /* The original class has protected functions and a pure virtual
@@ -343,9 +1076,33 @@ void gl(py::module& m) {
             /* Public interface */
             .def_property_readonly("id", &GL::AbstractShaderProgram::id, "OpenGL program ID")
             .def("validate", &GL::AbstractShaderProgram::validate, "Validate program")
-            .def("draw", static_cast<void(GL::AbstractShaderProgram::*)(GL::Mesh&)>(&GL::AbstractShaderProgram::draw), "Draw a mesh")
+            .def("draw", [](GL::AbstractShaderProgram& self, GL::Mesh& mesh) {
+                checkLinkAndCountDraws(self, 1);
+                /* Not touching any Python state, so other threads can run
+                   while the driver is busy. Opt-in, as releasing and
+                   reacquiring the GIL isn't free and a draw usually doesn't
+                   block. */
+                if(releaseGilOnDraw) {
+                    py::gil_scoped_release release;
+                    self.draw(mesh);
+                } else self.draw(mesh);
+            }, "Draw a mesh")
+            .def_property_static("release_gil_on_draw", [](py::object) {
+                return releaseGilOnDraw;
+            }, [](py::object, bool enabled) {
+                releaseGilOnDraw = enabled;
+            }, "Whether draw() releases the GIL")
+            #ifndef MAGNUM_TARGET_GLES
+            .def("draw_transform_feedback", [](GL::AbstractShaderProgram& self, GL::Mesh& mesh, GL::TransformFeedback& xfb, UnsignedInt stream) {
+                checkLinkAndCountDraws(self, 1);
+                self.drawTransformFeedback(mesh, xfb, stream);
+            }, "Draw a mesh with vertex count taken from a transform feedback", py::arg("mesh"), py::arg("xfb"), py::arg("stream") = 0)
+            #endif
             #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-            .def("dispatch_compute", &GL::AbstractShaderProgram::dispatchCompute, "Dispatch compute")
+            .def("dispatch_compute", [](GL::AbstractShaderProgram& self, const Vector3ui& workgroupCount) {
+                countProgramUse(self);
+                self.dispatchCompute(workgroupCount);
+            }, "Dispatch compute")
             #endif
 
             /* Protected interface */
@@ -370,17 +1127,41 @@ void gl(py::module& m) {
                 static_cast<PublicizedAbstractShaderProgram&>(self).bindFragmentDataLocation(location, name);
             }, "Bind fragment data to given location and first color input index", py::arg("location"), py::arg("name"))
             #endif
-            /** @todo setTransformFeedbackOutputs, list-taking link functions */
+            #ifndef MAGNUM_TARGET_GLES2
+            .def("set_transform_feedback_outputs", [](GL::AbstractShaderProgram& self, const std::vector<std::string>& outputs, GL::AbstractShaderProgram::TransformFeedbackBufferMode bufferMode) {
+                /* The Magnum API takes only an initializer list, so calling
+                   the GL function directly */
+                std::vector<const char*> names;
+                names.reserve(outputs.size());
+                for(const std::string& output: outputs)
+                    names.push_back(output.data());
+                glTransformFeedbackVaryings(self.id(), names.size(), names.data(), GLenum(bufferMode));
+            }, "Specify shader outputs to be recorded in transform feedback", py::arg("outputs"), py::arg("buffer_mode"))
+            #endif
+            /** @todo list-taking link functions */
             /* Somehow the overload static_casts don't work and it complains it
                can't bind a protected function, have to use lambdas */
             .def("link", [](GL::AbstractShaderProgram& self) {
                 /** @todo log redirection -- but we'd need assertions to not be
                     part of that so when it dies, the user can still see why */
+                pendingLinks.erase(self.id());
                 if(!static_cast<PublicizedAbstractShaderProgram&>(self).link()) {
                     PyErr_SetString(PyExc_RuntimeError, "linking failed");
                     throw py::error_already_set{};
                 }
             }, "Link the shader")
+            .def("link_async", linkAsync, "Submit the program for linking without waiting for the result")
+            .def_property_readonly("link_finished", [](GL::AbstractShaderProgram& self) {
+                if(!pendingLinks.count(self.id()) || !parallelShaderCompile()) return true;
+                GLint status;
+                glGetProgramiv(self.id(), GL_COMPLETION_STATUS_KHR, &status);
+                return status == GL_TRUE;
+            }, "Whether asynchronous linking finished")
+            .def("check_link", checkLink, "Check result of asynchronous linking")
+            .def_static("link_all", [](py::iterable programs) {
+                for(py::handle program: programs)
+                    linkAsync(py::cast<GL::AbstractShaderProgram&>(program));
+            }, "Submit programs for linking without waiting for the result", py::arg("programs"))
             .def("uniform_location", [](GL::AbstractShaderProgram& self, const std::string& name) {
                 /** @todo log redirection -- but we'd need assertions to not be
                     part of that so when it dies, the user can still see why */
@@ -445,12 +1226,47 @@ void gl(py::module& m) {
             .def("set_uniform", setUniform<Matrix3x4d>, "Set uniform value")
             .def("set_uniform", setUniform<Matrix4x3d>, "Set uniform value")
             #endif
+            .def("set_uniform_array", setUniformArray, "Set uniform array",
+                py::arg("location"), py::arg("values"))
+            .def("uniform_setter", [](GL::AbstractShaderProgram& self, Int location, py::handle type) {
+                const UniformSetter::Function set = uniformSetterFor(type);
+                if(!set) {
+                    PyErr_Format(PyExc_TypeError, "unsupported uniform type %A", type.ptr());
+                    throw py::error_already_set{};
+                }
+
+                return UniformSetter{self, location, set};
+            }, "Uniform setter for given location and type",
+                py::arg("location"), py::arg("type"), py::keep_alive<0, 1>())
             #ifndef MAGNUM_TARGET_GLES2
             .def("set_uniform_block_binding", &PublicizedAbstractShaderProgram::setUniformBlockBinding, "Set uniform block binding")
             #endif
             ;
+
+        py::class_<UniformSetter>{m, "UniformSetter", "Uniform setter"}
+            .def_property_readonly("location", [](UniformSetter& self) {
+                return self.location;
+            }, "Uniform location")
+            .def("__call__", [](UniformSetter& self, py::handle value) {
+                self.set(self.program, self.location, value);
+            }, "Set uniform value", py::arg("value"));
     }
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    py::class_<ProgramBinaryCache>{m, "ProgramBinaryCache", "Program binary cache"}
+        .def(py::init<std::string>(), "Constructor", py::arg("directory"))
+        .def_property_readonly_static("supported", [](py::object) {
+            GLint count{};
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+            return count != 0;
+        }, "Whether the driver supports retrieving program binaries")
+        .def_property_readonly("directory", [](ProgramBinaryCache& self) {
+            return self.directory;
+        }, "Cache directory")
+        .def("load", &ProgramBinaryCache::load, "Load a cached program binary", py::arg("program"), py::arg("key"))
+        .def("save", &ProgramBinaryCache::save, "Save a program binary to the cache", py::arg("program"), py::arg("key"));
+    #endif
+
     /* (Dynamic) attribute */
     py::class_<GL::DynamicAttribute> attribute{m, "Attribute", "Vertex attribute location and type"};
 
@@ -554,17 +1370,129 @@ void gl(py::module& m) {
         #endif
         ;
 
+    #ifndef MAGNUM_TARGET_GLES2
+    py::enum_<GL::Buffer::Target>{buffer, "Target", "Buffer binding target"}
+        #ifndef MAGNUM_TARGET_WEBGL
+        .value("ATOMIC_COUNTER", GL::Buffer::Target::AtomicCounter)
+        .value("SHADER_STORAGE", GL::Buffer::Target::ShaderStorage)
+        #endif
+        .value("UNIFORM", GL::Buffer::Target::Uniform);
+    #endif
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    py::enum_<GL::Buffer::MapFlag> bufferMapFlag{buffer, "MapFlag", "Memory mapping flag"};
+    bufferMapFlag
+        .value("READ", GL::Buffer::MapFlag::Read)
+        .value("WRITE", GL::Buffer::MapFlag::Write)
+        .value("INVALIDATE_BUFFER", GL::Buffer::MapFlag::InvalidateBuffer)
+        .value("INVALIDATE_RANGE", GL::Buffer::MapFlag::InvalidateRange)
+        .value("FLUSH_EXPLICIT", GL::Buffer::MapFlag::FlushExplicit)
+        .value("UNSYNCHRONIZED", GL::Buffer::MapFlag::Unsynchronized);
+    corrade::enumOperators(bufferMapFlag);
+    #endif
+
     buffer
         /** @todo limit queries */
         .def(py::init<GL::Buffer::TargetHint>(), "Constructor", py::arg("target_hint") = GL::Buffer::TargetHint::Array)
         .def_property_readonly("id", &GL::Buffer::id, "OpenGL buffer ID")
         .def_property("target_hint", &GL::Buffer::targetHint, &GL::Buffer::setTargetHint, "Target hint")
+        #ifndef MAGNUM_TARGET_GLES2
+        .def_static("unbind", [](GL::Buffer::Target target, UnsignedInt index) {
+            GL::Buffer::unbind(target, index);
+        }, "Unbind any buffer from given indexed target", py::arg("target"), py::arg("index"))
+        /* Using lambdas to avoid method chaining getting into signatures */
+        .def("bind", [](GL::Buffer& self, GL::Buffer::Target target, UnsignedInt index) {
+            if(rendererStatistics.enabled) ++rendererStatistics.bufferBinds;
+            self.bind(target, index);
+        }, "Bind buffer to given binding index of an indexed target", py::arg("target"), py::arg("index"))
+        .def("bind", [](GL::Buffer& self, GL::Buffer::Target target, UnsignedInt index, GLintptr offset, GLsizeiptr size) {
+            if(rendererStatistics.enabled) ++rendererStatistics.bufferBinds;
+            self.bind(target, index, offset, size);
+        }, "Bind buffer range to given binding index of an indexed target", py::arg("target"), py::arg("index"), py::arg("offset"), py::arg("size"))
+        #endif
         /* Using lambdas to avoid method chaining getting into signatures */
         .def("set_data", [](GL::Buffer& self, const Containers::ArrayView<const char>& data, GL::BufferUsage usage) {
             self.setData(data, usage);
         }, "Set buffer data", py::arg("data"), py::arg("usage") = GL::BufferUsage::StaticDraw)
+        #ifndef MAGNUM_TARGET_WEBGL
+        .def("map", [](GL::Buffer& self, GLintptr offset, GLsizeiptr length, GL::Buffer::MapFlag flags) {
+            const Containers::ArrayView<char> data = self.map(offset, length, flags);
+            if(!data) {
+                PyErr_SetString(PyExc_RuntimeError, "mapping failed");
+                throw py::error_already_set{};
+            }
+
+            /* Read-only mappings are exposed as immutable views, the buffer
+               is the memory owner */
+            if(!(GL::Buffer::MapFlags{flags} & GL::Buffer::MapFlag::Write))
+                return pyCastButNotShitty(Containers::pyArrayViewHolder(Containers::ArrayView<const char>{data}, py::cast(self)));
+            return pyCastButNotShitty(Containers::pyArrayViewHolder(data, py::cast(self)));
+        }, "Map buffer to client memory", py::arg("offset"), py::arg("length"), py::arg("flags"))
+        .def("unmap", [](GL::Buffer& self) {
+            if(!self.unmap()) {
+                PyErr_SetString(PyExc_RuntimeError, "buffer data got corrupted while mapped");
+                throw py::error_already_set{};
+            }
+        }, "Unmap buffer")
+        #endif
         /** @todo more */;
 
+    #ifndef MAGNUM_TARGET_GLES2
+    py::class_<GL::BufferImage1D> bufferImage1D{m, "BufferImage1D", "One-dimensional buffer image"};
+    py::class_<GL::BufferImage2D> bufferImage2D{m, "BufferImage2D", "Two-dimensional buffer image"};
+    py::class_<GL::BufferImage3D> bufferImage3D{m, "BufferImage3D", "Three-dimensional buffer image"};
+    bufferImage(bufferImage1D);
+    bufferImage(bufferImage2D);
+    bufferImage(bufferImage3D);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    py::class_<AsyncReadback>{m, "AsyncReadback", "Pending asynchronous framebuffer readback"}
+        .def_property_readonly("image", [](AsyncReadback& self) {
+            return self.image;
+        }, "Buffer image the pixels are read into")
+        .def_property_readonly("is_ready", &AsyncReadback::ready, "Whether the GPU finished the readback")
+        .def("wait", [](AsyncReadback& self, Float timeout) {
+            return self.wait(GLuint64(Double(timeout)*1000000000.0));
+        }, "Wait until the GPU finishes the readback", py::arg("timeout") = 1.0f)
+        .def("map", [](AsyncReadback& self) {
+            if(!self.wait(~GLuint64{})) {
+                PyErr_SetString(PyExc_RuntimeError, "readback didn't finish");
+                throw py::error_already_set{};
+            }
+            if(self.mapped) {
+                PyErr_SetString(PyExc_RuntimeError, "the buffer is already mapped");
+                throw py::error_already_set{};
+            }
+
+            GL::BufferImage2D& image = self.bufferImage();
+            const Containers::ArrayView<const char> data = image.buffer().map(0, image.dataSize(), GL::Buffer::MapFlag::Read);
+            if(!data) {
+                PyErr_SetString(PyExc_RuntimeError, "mapping failed");
+                throw py::error_already_set{};
+            }
+            self.mapped = true;
+
+            /* The readback is the memory owner, so the view keeps it alive
+               for as long as needed */
+            PixelFormat format;
+            if(genericPixelFormat(image.format(), image.type(), format))
+                return pyImageViewHolder(ImageView2D{image.storage(), format, image.size(), data}, py::cast(self));
+            return pyImageViewHolder(ImageView2D{image.storage(), image.format(), image.type(), image.size(), data}, py::cast(self));
+        }, "Map the pixels to client memory")
+        .def("unmap", [](AsyncReadback& self) {
+            if(!self.mapped) {
+                PyErr_SetString(PyExc_RuntimeError, "the buffer is not mapped");
+                throw py::error_already_set{};
+            }
+            self.mapped = false;
+            if(!self.bufferImage().buffer().unmap()) {
+                PyErr_SetString(PyExc_RuntimeError, "buffer data got corrupted while mapped");
+                throw py::error_already_set{};
+            }
+        }, "Unmap the pixels");
+    #endif
+    #endif
+
     /* Renderbuffer */
     py::enum_<GL::RenderbufferFormat>{m, "RenderbufferFormat", "Internal renderbuffer format"}
         #ifndef MAGNUM_TARGET_GLES
@@ -701,7 +1629,10 @@ void gl(py::module& m) {
         .def_static("blit", [](GL::AbstractFramebuffer& source, GL::AbstractFramebuffer& destination, const Range2Di& rectangle, GL::FramebufferBlit mask) {
             GL::AbstractFramebuffer::blit(source, destination, rectangle, mask);
         }, "Copy a block of pixels", py::arg("source"), py::arg("destination"), py::arg("rectangle"), py::arg("mask"))
-        .def("bind", &GL::AbstractFramebuffer::bind, "Bind framebuffer for drawing")
+        .def("bind", [](GL::AbstractFramebuffer& self) {
+            if(rendererStatistics.enabled) ++rendererStatistics.framebufferBinds;
+            self.bind();
+        }, "Bind framebuffer for drawing")
         .def_property("viewport", &GL::AbstractFramebuffer::viewport, &GL::AbstractFramebuffer::setViewport, "Viewport")
         /* Using lambdas to avoid method chaining getting into signatures */
         .def("clear", [](GL::AbstractFramebuffer& self, GL::FramebufferClear mask) {
@@ -709,6 +1640,15 @@ void gl(py::module& m) {
         }, "Clear specified buffers in the framebuffer")
         .def("read", static_cast<void(GL::AbstractFramebuffer::*)(const Range2Di&, const MutableImageView2D&)>(&GL::AbstractFramebuffer::read), "Read a block of pixels from the framebuffer to an image view", py::arg("rectangle"), py::arg("image"))
         .def("read", static_cast<void(GL::AbstractFramebuffer::*)(const Range2Di&, Image2D&)>(&GL::AbstractFramebuffer::read), "Read a block of pixels from the framebuffer to an image", py::arg("rectangle"), py::arg("image"))
+        #ifndef MAGNUM_TARGET_GLES2
+        .def("read", static_cast<void(GL::AbstractFramebuffer::*)(const Range2Di&, GL::BufferImage2D&, GL::BufferUsage)>(&GL::AbstractFramebuffer::read), "Read a block of pixels from the framebuffer to a buffer image", py::arg("rectangle"), py::arg("image"), py::arg("usage"))
+        #ifndef MAGNUM_TARGET_WEBGL
+        .def("read_async", [](GL::AbstractFramebuffer& self, const Range2Di& rectangle, GL::BufferImage2D& image) {
+            self.read(rectangle, image, GL::BufferUsage::StreamRead);
+            return std::unique_ptr<AsyncReadback>{new AsyncReadback{py::cast(image)}};
+        }, "Read a block of pixels from the framebuffer to a buffer image asynchronously", py::arg("rectangle"), py::arg("image"))
+        #endif
+        #endif
         /** @todo more */;
 
     py::class_<GL::DefaultFramebuffer, GL::AbstractFramebuffer, NonDefaultFramebufferHolder<GL::DefaultFramebuffer>> defaultFramebuffer{m,
@@ -758,7 +1698,19 @@ void gl(py::module& m) {
 
         .def_property_readonly("attachments", [](GL::Framebuffer& self) {
             return pyObjectHolderFor<GL::PyFramebufferHolder>(self).attachments;
-        }, "Renderbuffer and texture objects referenced by the framebuffer");
+        }, "Renderbuffer and texture objects referenced by the framebuffer")
+        #ifndef MAGNUM_TARGET_GLES2
+        .def("resolve_and_read", [](GL::Framebuffer& self, const Range2Di& rectangle, Image2D& image, GL::RenderbufferFormat format) {
+            resolveFramebuffer(self, rectangle, format).read({{}, rectangle.size()}, image);
+        }, "Resolve a block of multisampled pixels and read them to an image", py::arg("rectangle"), py::arg("image"), py::arg("format") = GL::RenderbufferFormat::RGBA8)
+        #ifndef MAGNUM_TARGET_WEBGL
+        .def("resolve_and_read_async", [](GL::Framebuffer& self, const Range2Di& rectangle, GL::BufferImage2D& image, GL::RenderbufferFormat format) {
+            resolveFramebuffer(self, rectangle, format).read({{}, rectangle.size()}, image, GL::BufferUsage::StreamRead);
+            return std::unique_ptr<AsyncReadback>{new AsyncReadback{py::cast(image)}};
+        }, "Resolve a block of multisampled pixels and read them to a buffer image asynchronously", py::arg("rectangle"), py::arg("image"), py::arg("format") = GL::RenderbufferFormat::RGBA8)
+        #endif
+        #endif
+        ;
 
     /* An equivalent to this would be
         m.attr("default_framebuffer") = &GL::defaultFramebuffer;
@@ -825,6 +1777,143 @@ void gl(py::module& m) {
             return pyObjectHolderFor<GL::PyMeshHolder>(self).buffers;
         }, "Buffer objects referenced by the mesh");
 
+    /* Transform feedback */
+    #ifndef MAGNUM_TARGET_GLES2
+    py::enum_<GL::TransformFeedback::PrimitiveMode>{transformFeedback, "PrimitiveMode", "Transform feedback primitive mode"}
+        .value("POINTS", GL::TransformFeedback::PrimitiveMode::Points)
+        .value("LINES", GL::TransformFeedback::PrimitiveMode::Lines)
+        .value("TRIANGLES", GL::TransformFeedback::PrimitiveMode::Triangles);
+
+    transformFeedback
+        .def(py::init(), "Constructor")
+        .def_property_readonly("id", &GL::TransformFeedback::id, "OpenGL transform feedback ID")
+
+        /* Using lambdas to avoid method chaining getting into signatures */
+
+        .def("attach_buffer", [](GL::TransformFeedback& self, UnsignedInt index, GL::Buffer& buffer, GLintptr offset, GLsizeiptr size) {
+            self.attachBuffer(index, buffer, offset, size);
+
+            /* Keep a reference to the buffer to avoid it being deleted before
+               the transform feedback. Replacing the previous one at the same
+               index. */
+            std::vector<py::object>& buffers = pyObjectHolderFor<GL::PyTransformFeedbackHolder>(self).buffers;
+            if(buffers.size() <= index) buffers.resize(index + 1, py::none{});
+            buffers[index] = pyObjectFromInstance(buffer);
+        }, "Attach a range of a buffer", py::arg("index"), py::arg("buffer"), py::arg("offset"), py::arg("size"))
+        .def("attach_buffer", [](GL::TransformFeedback& self, UnsignedInt index, GL::Buffer& buffer) {
+            self.attachBuffer(index, buffer);
+
+            std::vector<py::object>& buffers = pyObjectHolderFor<GL::PyTransformFeedbackHolder>(self).buffers;
+            if(buffers.size() <= index) buffers.resize(index + 1, py::none{});
+            buffers[index] = pyObjectFromInstance(buffer);
+        }, "Attach a whole buffer", py::arg("index"), py::arg("buffer"))
+        .def_property_readonly("buffers", [](GL::TransformFeedback& self) {
+            return pyObjectHolderFor<GL::PyTransformFeedbackHolder>(self).buffers;
+        }, "Buffer objects attached to the transform feedback")
+        .def("begin", [](GL::TransformFeedback& self, GL::AbstractShaderProgram& shader, GL::TransformFeedback::PrimitiveMode mode) {
+            countProgramUse(shader);
+            self.begin(shader, mode);
+        }, "Begin transform feedback", py::arg("shader"), py::arg("mode"))
+        .def("pause", [](GL::TransformFeedback& self) {
+            self.pause();
+        }, "Pause transform feedback")
+        .def("resume", [](GL::TransformFeedback& self) {
+            self.resume();
+        }, "Resume transform feedback")
+        .def("end", [](GL::TransformFeedback& self) {
+            self.end();
+        }, "End transform feedback");
+    #endif
+
+    /* Queries */
+    PyNonDestructibleClass<GL::AbstractQuery>{m, "AbstractQuery", "Base for queries"}
+        .def_property_readonly("id", &GL::AbstractQuery::id, "OpenGL query ID")
+        .def_property_readonly("result_available", &GL::AbstractQuery::resultAvailable, "Whether the result is available")
+        .def("begin", static_cast<void(GL::AbstractQuery::*)()>(&GL::AbstractQuery::begin), "Begin query")
+        .def("end", &GL::AbstractQuery::end, "End query");
+
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    {
+        py::class_<GL::SampleQuery, GL::AbstractQuery> sampleQuery{m, "SampleQuery", "Query for samples"};
+
+        py::enum_<GL::SampleQuery::Target>{sampleQuery, "Target", "Query target"}
+            #ifndef MAGNUM_TARGET_GLES
+            .value("SAMPLES_PASSED", GL::SampleQuery::Target::SamplesPassed)
+            #endif
+            .value("ANY_SAMPLES_PASSED", GL::SampleQuery::Target::AnySamplesPassed)
+            .value("ANY_SAMPLES_PASSED_CONSERVATIVE", GL::SampleQuery::Target::AnySamplesPassedConservative);
+
+        sampleQuery
+            .def(py::init<GL::SampleQuery::Target>(), "Constructor", py::arg("target"))
+            .def_property_readonly("result", [](GL::SampleQuery& self) {
+                return self.result<UnsignedInt>();
+            }, "Result")
+            /** @todo conditional rendering */;
+    }
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    {
+        py::class_<GL::PrimitiveQuery, GL::AbstractQuery> primitiveQuery{m, "PrimitiveQuery", "Query for primitives"};
+
+        py::enum_<GL::PrimitiveQuery::Target>{primitiveQuery, "Target", "Query target"}
+            #ifndef MAGNUM_TARGET_WEBGL
+            .value("PRIMITIVES_GENERATED", GL::PrimitiveQuery::Target::PrimitivesGenerated)
+            #endif
+            .value("TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN", GL::PrimitiveQuery::Target::TransformFeedbackPrimitivesWritten);
+
+        primitiveQuery
+            .def(py::init<GL::PrimitiveQuery::Target>(), "Constructor", py::arg("target"))
+            #ifndef MAGNUM_TARGET_GLES
+            /* The indexed overload would hide the base one otherwise */
+            .def("begin", [](GL::PrimitiveQuery& self) {
+                static_cast<GL::AbstractQuery&>(self).begin();
+            }, "Begin query")
+            .def("begin", static_cast<void(GL::PrimitiveQuery::*)(UnsignedInt)>(&GL::PrimitiveQuery::begin), "Begin an indexed query", py::arg("index"))
+            #endif
+            .def_property_readonly("result", [](GL::PrimitiveQuery& self) {
+                return self.result<UnsignedInt>();
+            }, "Result");
+    }
+    #endif
+
+    {
+        py::class_<GL::TimeQuery, GL::AbstractQuery> timeQuery{m, "TimeQuery", "Query for elapsed time"};
+
+        py::enum_<GL::TimeQuery::Target>{timeQuery, "Target", "Query target"}
+            .value("TIME_ELAPSED", GL::TimeQuery::Target::TimeElapsed)
+            .value("TIMESTAMP", GL::TimeQuery::Target::Timestamp);
+
+        timeQuery
+            .def(py::init<GL::TimeQuery::Target>(), "Constructor", py::arg("target"))
+            .def("timestamp", &GL::TimeQuery::timestamp, "Query timestamp")
+            .def_property_readonly("result", [](GL::TimeQuery& self) {
+                return self.result<UnsignedLong>();
+            }, "Result in nanoseconds");
+    }
+
+    py::class_<FrameTimer>{m, "FrameTimer", "GPU time measurement of a frame section"}
+        .def(py::init([](UnsignedInt delay) {
+            if(!delay) {
+                PyErr_SetString(PyExc_ValueError, "delay has to be at least one frame");
+                throw py::error_already_set{};
+            }
+            return std::unique_ptr<FrameTimer>{new FrameTimer{delay}};
+        }), "Constructor", py::arg("delay") = 3)
+        .def("begin", &FrameTimer::begin, "Begin the measured section")
+        .def("end", &FrameTimer::end, "End the measured section")
+        .def("__enter__", [](FrameTimer& self) {
+            self.begin();
+        }, "Begin the measured section")
+        .def("__exit__", [](FrameTimer& self, py::args) {
+            self.end();
+        }, "End the measured section")
+        .def_property_readonly("duration", [](FrameTimer& self) -> py::object {
+            self.poll();
+            if(self.duration < 0.0) return py::none{};
+            return py::float_(self.duration);
+        }, "Latest available GPU duration of the section in milliseconds");
+
     /* Renderer */
     {
         py::class_<GL::Renderer> renderer{m, "Renderer", "Global renderer configuration"};
@@ -884,16 +1973,83 @@ void gl(py::module& m) {
             .value("SCISSOR_TEST", GL::Renderer::Feature::ScissorTest)
             .value("STENCIL_TEST", GL::Renderer::Feature::StencilTest);
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        py::enum_<GL::Renderer::MemoryBarrier> memoryBarrier{renderer, "MemoryBarrier", "Memory barrier"};
+        memoryBarrier
+            .value("VERTEX_ATTRIBUTE_ARRAY", GL::Renderer::MemoryBarrier::VertexAttributeArray)
+            .value("ELEMENT_ARRAY", GL::Renderer::MemoryBarrier::ElementArray)
+            .value("UNIFORM", GL::Renderer::MemoryBarrier::Uniform)
+            .value("TEXTURE_FETCH", GL::Renderer::MemoryBarrier::TextureFetch)
+            .value("SHADER_IMAGE_ACCESS", GL::Renderer::MemoryBarrier::ShaderImageAccess)
+            .value("COMMAND", GL::Renderer::MemoryBarrier::Command)
+            .value("PIXEL_BUFFER", GL::Renderer::MemoryBarrier::PixelBuffer)
+            .value("TEXTURE_UPDATE", GL::Renderer::MemoryBarrier::TextureUpdate)
+            .value("BUFFER_UPDATE", GL::Renderer::MemoryBarrier::BufferUpdate)
+            .value("FRAMEBUFFER", GL::Renderer::MemoryBarrier::Framebuffer)
+            .value("TRANSFORM_FEEDBACK", GL::Renderer::MemoryBarrier::TransformFeedback)
+            .value("ATOMIC_COUNTER", GL::Renderer::MemoryBarrier::AtomicCounter)
+            .value("SHADER_STORAGE", GL::Renderer::MemoryBarrier::ShaderStorage);
+        corrade::enumOperators(memoryBarrier);
+        #endif
+
         renderer
-            .def_static("enable", static_cast<void(*)(GL::Renderer::Feature)>(GL::Renderer::enable), "Enable a feature")
-            .def_static("disable", static_cast<void(*)(GL::Renderer::Feature)>(GL::Renderer::disable), "Disable a feature")
-            .def_static("set_feature", static_cast<void(*)(GL::Renderer::Feature, bool)>(GL::Renderer::setFeature), "Enable or disable a feature")
+            .def_static("enable", [](GL::Renderer::Feature feature) {
+                setFeature(feature, true);
+            }, "Enable a feature")
+            .def_static("disable", [](GL::Renderer::Feature feature) {
+                setFeature(feature, false);
+            }, "Disable a feature")
+            .def_static("set_feature", setFeature, "Enable or disable a feature")
             /** @todo indexed variants */
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            .def_static("set_memory_barrier", [](GL::Renderer::MemoryBarrier barriers) {
+                GL::Renderer::setMemoryBarrier(barriers);
+            }, "Set memory barrier", py::arg("barriers"))
+            .def_static("set_memory_barrier_by_region", [](GL::Renderer::MemoryBarrier barriers) {
+                GL::Renderer::setMemoryBarrierByRegion(barriers);
+            }, "Set memory barrier by region", py::arg("barriers"))
+            #endif
 
             /** @todo FFS why do I have to pass the class as first argument?! */
             .def_property_static("clear_color", nullptr, [](py::object, const Color4& color) {
+                if(rendererStatistics.enabled) {
+                    RendererState& state = rendererStatistics.state();
+                    if(state.hasClearColor && state.clearColor == color) {
+                        ++rendererStatistics.redundantStateChanges;
+                        return;
+                    }
+
+                    state.hasClearColor = true;
+                    state.clearColor = color;
+                    ++rendererStatistics.stateChanges;
+                }
+
                 GL::Renderer::setClearColor(color);
             }, "Set clear color")
+
+            /* Statistics */
+            .def_property_static("statistics_enabled", [](py::object) {
+                return rendererStatistics.enabled;
+            }, [](py::object, bool enabled) {
+                /* The shadow state might be stale after being disabled */
+                if(enabled && !rendererStatistics.enabled)
+                    rendererStatistics.states.clear();
+                rendererStatistics.enabled = enabled;
+            }, "Whether renderer statistics are collected")
+            .def_property_readonly_static("statistics", [](py::object) {
+                py::dict out;
+                out["draw_calls"] = rendererStatistics.drawCalls;
+                out["program_switches"] = rendererStatistics.programSwitches;
+                out["texture_binds"] = rendererStatistics.textureBinds;
+                out["buffer_binds"] = rendererStatistics.bufferBinds;
+                out["framebuffer_binds"] = rendererStatistics.framebufferBinds;
+                out["state_changes"] = rendererStatistics.stateChanges;
+                out["redundant_state_changes"] = rendererStatistics.redundantStateChanges;
+                return out;
+            }, "Renderer statistics")
+            .def_static("reset_statistics", []() {
+                rendererStatistics.reset();
+            }, "Reset renderer statistics")
             .def_property_readonly_static("error", [](py::object) {
                 return GL::Renderer::error();
             }, "Error status");
@@ -1061,12 +2217,76 @@ void gl(py::module& m) {
         ;
         /** @todo compressed formats */
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    py::enum_<GL::ImageAccess>{m, "ImageAccess", "Image access"}
+        .value("READ_ONLY", GL::ImageAccess::ReadOnly)
+        .value("WRITE_ONLY", GL::ImageAccess::WriteOnly)
+        .value("READ_WRITE", GL::ImageAccess::ReadWrite);
+
+    py::enum_<GL::ImageFormat>{m, "ImageFormat", "Image format"}
+        .value("R32F", GL::ImageFormat::R32F)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("RG32F", GL::ImageFormat::RG32F)
+        #endif
+        .value("RGBA32F", GL::ImageFormat::RGBA32F)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("R16F", GL::ImageFormat::R16F)
+        .value("RG16F", GL::ImageFormat::RG16F)
+        #endif
+        .value("RGBA16F", GL::ImageFormat::RGBA16F)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("R11FG11FB10F", GL::ImageFormat::R11FG11FB10F)
+        #endif
+        .value("R32UI", GL::ImageFormat::R32UI)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("RG32UI", GL::ImageFormat::RG32UI)
+        #endif
+        .value("RGBA32UI", GL::ImageFormat::RGBA32UI)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("R16UI", GL::ImageFormat::R16UI)
+        .value("RG16UI", GL::ImageFormat::RG16UI)
+        #endif
+        .value("RGBA16UI", GL::ImageFormat::RGBA16UI)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("R8UI", GL::ImageFormat::R8UI)
+        .value("RG8UI", GL::ImageFormat::RG8UI)
+        #endif
+        .value("RGBA8UI", GL::ImageFormat::RGBA8UI)
+        .value("R32I", GL::ImageFormat::R32I)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("RG32I", GL::ImageFormat::RG32I)
+        #endif
+        .value("RGBA32I", GL::ImageFormat::RGBA32I)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("R16I", GL::ImageFormat::R16I)
+        .value("RG16I", GL::ImageFormat::RG16I)
+        #endif
+        .value("RGBA16I", GL::ImageFormat::RGBA16I)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("R8I", GL::ImageFormat::R8I)
+        .value("RG8I", GL::ImageFormat::RG8I)
+        #endif
+        .value("RGBA8I", GL::ImageFormat::RGBA8I)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("R8", GL::ImageFormat::R8)
+        .value("RG8", GL::ImageFormat::RG8)
+        #endif
+        .value("RGBA8", GL::ImageFormat::RGBA8)
+        .value("RGBA8_SNORM", GL::ImageFormat::RGBA8Snorm);
+    #endif
+
     PyNonDestructibleClass<GL::AbstractTexture>{m, "AbstractTexture", "Base for textures"}
         .def_static("unbind", static_cast<void(*)(Int)>(&GL::AbstractTexture::unbind), "Unbind any texture from given texture unit")
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .def_static("unbind_image", &GL::AbstractTexture::unbindImage, "Unbind any image from given image unit", py::arg("image_unit"))
+        #endif
         /** @todo limits */
         .def_property_readonly("id", &GL::AbstractTexture::id, "OpenGL texture ID")
         /** @todo list-taking bind */
-        .def("bind", static_cast<void(GL::AbstractTexture::*)(Int)>(&GL::AbstractTexture::bind), "Bind texture to given texture unit");
+        .def("bind", [](GL::AbstractTexture& self, Int textureUnit) {
+            if(rendererStatistics.enabled) ++rendererStatistics.textureBinds;
+            self.bind(textureUnit);
+        }, "Bind texture to given texture unit");
 
     #ifndef MAGNUM_TARGET_GLES
     py::class_<GL::Texture1D, GL::AbstractTexture> texture1D{m, "Texture1D", "One-dimensional texture"};
@@ -1078,6 +2298,232 @@ void gl(py::module& m) {
     py::class_<GL::Texture3D, GL::AbstractTexture> texture3D{m, "Texture3D", "Three-dimensional texture"};
     texture(texture3D);
     #endif
+
+    /* Image binding, which has a different signature for layered textures */
+    #ifndef MAGNUM_TARGET_GLES
+    texture1D.def("bind_image", [](GL::Texture1D& self, Int imageUnit, Int level, GL::ImageAccess access, GL::ImageFormat format) {
+        self.bindImage(imageUnit, level, access, format);
+    }, "Bind level of texture to given image unit", py::arg("image_unit"), py::arg("level"), py::arg("access"), py::arg("format"));
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    texture2D.def("bind_image", [](GL::Texture2D& self, Int imageUnit, Int level, GL::ImageAccess access, GL::ImageFormat format) {
+        self.bindImage(imageUnit, level, access, format);
+    }, "Bind level of texture to given image unit", py::arg("image_unit"), py::arg("level"), py::arg("access"), py::arg("format"));
+    texture3D
+        .def("bind_image", [](GL::Texture3D& self, Int imageUnit, Int level, Int layer, GL::ImageAccess access, GL::ImageFormat format) {
+            self.bindImage(imageUnit, level, layer, access, format);
+        }, "Bind level of given texture layer to given image unit", py::arg("image_unit"), py::arg("level"), py::arg("layer"), py::arg("access"), py::arg("format"))
+        .def("bind_image_layered", [](GL::Texture3D& self, Int imageUnit, Int level, GL::ImageAccess access, GL::ImageFormat format) {
+            self.bindImageLayered(imageUnit, level, access, format);
+        }, "Bind level of layered texture to given image unit", py::arg("image_unit"), py::arg("level"), py::arg("access"), py::arg("format"));
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    py::class_<GL::Texture1DArray, GL::AbstractTexture> texture1DArray{m, "Texture1DArray", "One-dimensional texture array"};
+    textureArray(texture1DArray);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    py::class_<GL::Texture2DArray, GL::AbstractTexture> texture2DArray{m, "Texture2DArray", "Two-dimensional texture array"};
+    textureArray(texture2DArray);
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    texture1DArray
+        .def("bind_image", [](GL::Texture1DArray& self, Int imageUnit, Int level, Int layer, GL::ImageAccess access, GL::ImageFormat format) {
+            self.bindImage(imageUnit, level, layer, access, format);
+        }, "Bind level of given texture layer to given image unit", py::arg("image_unit"), py::arg("level"), py::arg("layer"), py::arg("access"), py::arg("format"))
+        .def("bind_image_layered", [](GL::Texture1DArray& self, Int imageUnit, Int level, GL::ImageAccess access, GL::ImageFormat format) {
+            self.bindImageLayered(imageUnit, level, access, format);
+        }, "Bind level of layered texture to given image unit", py::arg("image_unit"), py::arg("level"), py::arg("access"), py::arg("format"));
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    texture2DArray
+        .def("bind_image", [](GL::Texture2DArray& self, Int imageUnit, Int level, Int layer, GL::ImageAccess access, GL::ImageFormat format) {
+            self.bindImage(imageUnit, level, layer, access, format);
+        }, "Bind level of given texture layer to given image unit", py::arg("image_unit"), py::arg("level"), py::arg("layer"), py::arg("access"), py::arg("format"))
+        .def("bind_image_layered", [](GL::Texture2DArray& self, Int imageUnit, Int level, GL::ImageAccess access, GL::ImageFormat format) {
+            self.bindImageLayered(imageUnit, level, access, format);
+        }, "Bind level of layered texture to given image unit", py::arg("image_unit"), py::arg("level"), py::arg("access"), py::arg("format"));
+    #endif
+
+    py::enum_<GL::CubeMapCoordinate>{m, "CubeMapCoordinate", "Cube map coordinate"}
+        .value("POSITIVE_X", GL::CubeMapCoordinate::PositiveX)
+        .value("NEGATIVE_X", GL::CubeMapCoordinate::NegativeX)
+        .value("POSITIVE_Y", GL::CubeMapCoordinate::PositiveY)
+        .value("NEGATIVE_Y", GL::CubeMapCoordinate::NegativeY)
+        .value("POSITIVE_Z", GL::CubeMapCoordinate::PositiveZ)
+        .value("NEGATIVE_Z", GL::CubeMapCoordinate::NegativeZ);
+
+    py::class_<GL::CubeMapTexture, GL::AbstractTexture> cubeMapTexture{m, "CubeMapTexture", "Cube map texture"};
+    sampler(cubeMapTexture);
+    cubeMapTexture
+        /** @todo limits */
+        .def(py::init(), "Constructor")
+        /** @todo bindImage(), bindImageLayered */
+        /* Using lambdas to avoid method chaining leaking to Python */
+        .def("set_storage", [](GL::CubeMapTexture& self, Int levels, GL::TextureFormat internalFormat, const Vector2i& size) {
+            self.setStorage(levels, internalFormat, size);
+        }, "Set storage", py::arg("levels"), py::arg("internal_format"), py::arg("size"))
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .def("image_size", &GL::CubeMapTexture::imageSize, "Image size in given mip level", py::arg("level"))
+        #endif
+        /** @todo (compressed/buffer) (sub)image queries */
+        .def("set_image", [](GL::CubeMapTexture& self, GL::CubeMapCoordinate coordinate, Int level, GL::TextureFormat internalFormat, const ImageView2D& image) {
+            self.setImage(coordinate, level, internalFormat, image);
+        }, "Set image data", py::arg("coordinate"), py::arg("level"), py::arg("internal_format"), py::arg("image"))
+        #ifndef MAGNUM_TARGET_GLES2
+        .def("set_image", [](GL::CubeMapTexture& self, GL::CubeMapCoordinate coordinate, Int level, GL::TextureFormat internalFormat, GL::BufferImage2D& image) {
+            self.setImage(coordinate, level, internalFormat, image);
+        }, "Set image data from a buffer", py::arg("coordinate"), py::arg("level"), py::arg("internal_format"), py::arg("image"))
+        #endif
+        /** @todo compressed setImage() */
+        .def("set_sub_image", [](GL::CubeMapTexture& self, GL::CubeMapCoordinate coordinate, Int level, const Vector2i& offset, const ImageView2D& image) {
+            self.setSubImage(coordinate, level, offset, image);
+        }, "Set image subdata", py::arg("coordinate"), py::arg("level"), py::arg("offset"), py::arg("image"))
+        #ifndef MAGNUM_TARGET_GLES2
+        .def("set_sub_image", [](GL::CubeMapTexture& self, GL::CubeMapCoordinate coordinate, Int level, const Vector2i& offset, GL::BufferImage2D& image) {
+            self.setSubImage(coordinate, level, offset, image);
+        }, "Set image subdata from a buffer", py::arg("coordinate"), py::arg("level"), py::arg("offset"), py::arg("image"))
+        #endif
+        /** @todo compressed setSubImage(), 3D setSubImage() */
+        .def("generate_mipmap", [](GL::CubeMapTexture& self) {
+            self.generateMipmap();
+        }, "Generate mipmap")
+        .def("invalidate_image", &GL::CubeMapTexture::invalidateImage, "Invalidate texture image", py::arg("level"))
+        .def("invalidate_sub_image", &GL::CubeMapTexture::invalidateSubImage, "Invalidate texture subimage", py::arg("level"), py::arg("offset"), py::arg("size"));
+
+    /** @todo cube map texture arrays */
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    py::enum_<GL::BufferTextureFormat>{m, "BufferTextureFormat", "Internal buffer texture format"}
+        .value("R8", GL::BufferTextureFormat::R8)
+        .value("RG8", GL::BufferTextureFormat::RG8)
+        .value("RGBA8", GL::BufferTextureFormat::RGBA8)
+        #ifndef MAGNUM_TARGET_GLES
+        .value("R16", GL::BufferTextureFormat::R16)
+        .value("RG16", GL::BufferTextureFormat::RG16)
+        .value("RGBA16", GL::BufferTextureFormat::RGBA16)
+        #endif
+        .value("R8UI", GL::BufferTextureFormat::R8UI)
+        .value("RG8UI", GL::BufferTextureFormat::RG8UI)
+        .value("RGBA8UI", GL::BufferTextureFormat::RGBA8UI)
+        .value("R8I", GL::BufferTextureFormat::R8I)
+        .value("RG8I", GL::BufferTextureFormat::RG8I)
+        .value("RGBA8I", GL::BufferTextureFormat::RGBA8I)
+        .value("R16UI", GL::BufferTextureFormat::R16UI)
+        .value("RG16UI", GL::BufferTextureFormat::RG16UI)
+        .value("RGBA16UI", GL::BufferTextureFormat::RGBA16UI)
+        .value("R16I", GL::BufferTextureFormat::R16I)
+        .value("RG16I", GL::BufferTextureFormat::RG16I)
+        .value("RGBA16I", GL::BufferTextureFormat::RGBA16I)
+        .value("R32UI", GL::BufferTextureFormat::R32UI)
+        .value("RG32UI", GL::BufferTextureFormat::RG32UI)
+        .value("RGB32UI", GL::BufferTextureFormat::RGB32UI)
+        .value("RGBA32UI", GL::BufferTextureFormat::RGBA32UI)
+        .value("R32I", GL::BufferTextureFormat::R32I)
+        .value("RG32I", GL::BufferTextureFormat::RG32I)
+        .value("RGB32I", GL::BufferTextureFormat::RGB32I)
+        .value("RGBA32I", GL::BufferTextureFormat::RGBA32I)
+        .value("R16F", GL::BufferTextureFormat::R16F)
+        .value("RG16F", GL::BufferTextureFormat::RG16F)
+        .value("RGBA16F", GL::BufferTextureFormat::RGBA16F)
+        .value("R32F", GL::BufferTextureFormat::R32F)
+        .value("RG32F", GL::BufferTextureFormat::RG32F)
+        .value("RGB32F", GL::BufferTextureFormat::RGB32F)
+        .value("RGBA32F", GL::BufferTextureFormat::RGBA32F);
+
+    /* The texture keeps a reference to the buffer to avoid it being deleted
+       before the texture. It's stored in an alias type, which is what every
+       BufferTexture instance gets constructed as, and replaced on every
+       set_buffer() call so the references don't accumulate. */
+    struct PyBufferTexture: GL::BufferTexture {
+        py::object buffer;
+    };
+    py::class_<GL::BufferTexture, GL::AbstractTexture, PyBufferTexture>{m, "BufferTexture", "Buffer texture"}
+        /** @todo limits */
+        .def(py::init_alias<>(), "Constructor")
+        .def_property_readonly("size", &GL::BufferTexture::size, "Texture size")
+        .def_property_readonly("buffer", [](GL::BufferTexture& self) -> py::object {
+            const py::object& buffer = static_cast<PyBufferTexture&>(self).buffer;
+            if(!buffer) return py::none{};
+            return buffer;
+        }, "Texture buffer or None")
+        /* Using lambdas to avoid method chaining leaking to Python */
+        .def("set_buffer", [](GL::BufferTexture& self, GL::BufferTextureFormat internalFormat, GL::Buffer& buffer) {
+            self.setBuffer(internalFormat, buffer);
+            static_cast<PyBufferTexture&>(self).buffer = pyObjectFromInstance(buffer);
+        }, "Set texture buffer", py::arg("internal_format"), py::arg("buffer"))
+        .def("set_buffer", [](GL::BufferTexture& self, GL::BufferTextureFormat internalFormat, GL::Buffer& buffer, GLintptr offset, GLsizeiptr size) {
+            self.setBuffer(internalFormat, buffer, offset, size);
+            static_cast<PyBufferTexture&>(self).buffer = pyObjectFromInstance(buffer);
+        }, "Set texture buffer", py::arg("internal_format"), py::arg("buffer"), py::arg("offset"), py::arg("size"));
+    #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    py::enum_<GL::MultisampleTextureSampleLocations>{m, "MultisampleTextureSampleLocations", "Multisample texture sample locations"}
+        .value("NOT_FIXED", GL::MultisampleTextureSampleLocations::NotFixed)
+        .value("FIXED", GL::MultisampleTextureSampleLocations::Fixed);
+
+    py::class_<GL::MultisampleTexture2D, GL::AbstractTexture>{m, "MultisampleTexture2D", "Two-dimensional multisample texture"}
+        /** @todo limits */
+        .def(py::init(), "Constructor")
+        /* Using a lambda to avoid method chaining leaking to Python */
+        .def("set_storage", [](GL::MultisampleTexture2D& self, Int samples, GL::TextureFormat internalFormat, const Vector2i& size, GL::MultisampleTextureSampleLocations sampleLocations) {
+            self.setStorage(samples, internalFormat, size, sampleLocations);
+        }, "Set storage", py::arg("samples"), py::arg("internal_format"), py::arg("size"), py::arg("sample_locations") = GL::MultisampleTextureSampleLocations::NotFixed)
+        .def("image_size", [](GL::MultisampleTexture2D& self) {
+            return self.imageSize();
+        }, "Image size")
+        .def("invalidate_image", [](GL::MultisampleTexture2D& self) {
+            self.invalidateImage();
+        }, "Invalidate texture image");
+    #endif
+
+    /* Framebuffer texture attachments. Defined here and not together with
+       the rest because the texture classes need to be registered first to
+       have them in the signatures. The framebuffer keeps a reference to the
+       textures to avoid them being deleted before the framebuffer. */
+    /* Using lambdas to avoid method chaining getting into signatures */
+    framebuffer
+        #ifndef MAGNUM_TARGET_GLES
+        .def("attach_texture", [](GL::Framebuffer& self, GL::Framebuffer::BufferAttachment attachment, GL::Texture1D& texture, Int level) {
+            self.attachTexture(attachment, texture, level);
+            pyObjectHolderFor<GL::PyFramebufferHolder>(self).attachments.emplace_back(pyObjectFromInstance(texture));
+        }, "Attach texture to given buffer", py::arg("attachment"), py::arg("texture"), py::arg("level"))
+        #endif
+        .def("attach_texture", [](GL::Framebuffer& self, GL::Framebuffer::BufferAttachment attachment, GL::Texture2D& texture, Int level) {
+            self.attachTexture(attachment, texture, level);
+            pyObjectHolderFor<GL::PyFramebufferHolder>(self).attachments.emplace_back(pyObjectFromInstance(texture));
+        }, "Attach texture to given buffer", py::arg("attachment"), py::arg("texture"), py::arg("level"))
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .def("attach_texture", [](GL::Framebuffer& self, GL::Framebuffer::BufferAttachment attachment, GL::MultisampleTexture2D& texture) {
+            self.attachTexture(attachment, texture);
+            pyObjectHolderFor<GL::PyFramebufferHolder>(self).attachments.emplace_back(pyObjectFromInstance(texture));
+        }, "Attach multisample texture to given buffer", py::arg("attachment"), py::arg("texture"))
+        #endif
+        .def("attach_cube_map_texture", [](GL::Framebuffer& self, GL::Framebuffer::BufferAttachment attachment, GL::CubeMapTexture& texture, GL::CubeMapCoordinate coordinate, Int level) {
+            self.attachCubeMapTexture(attachment, texture, coordinate, level);
+            pyObjectHolderFor<GL::PyFramebufferHolder>(self).attachments.emplace_back(pyObjectFromInstance(texture));
+        }, "Attach cube map texture to given buffer", py::arg("attachment"), py::arg("texture"), py::arg("coordinate"), py::arg("level"))
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        .def("attach_texture_layer", [](GL::Framebuffer& self, GL::Framebuffer::BufferAttachment attachment, GL::Texture3D& texture, Int level, Int layer) {
+            self.attachTextureLayer(attachment, texture, level, layer);
+            pyObjectHolderFor<GL::PyFramebufferHolder>(self).attachments.emplace_back(pyObjectFromInstance(texture));
+        }, "Attach texture layer to given buffer", py::arg("attachment"), py::arg("texture"), py::arg("level"), py::arg("layer"))
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        .def("attach_texture_layer", [](GL::Framebuffer& self, GL::Framebuffer::BufferAttachment attachment, GL::Texture1DArray& texture, Int level, Int layer) {
+            self.attachTextureLayer(attachment, texture, level, layer);
+            pyObjectHolderFor<GL::PyFramebufferHolder>(self).attachments.emplace_back(pyObjectFromInstance(texture));
+        }, "Attach texture layer to given buffer", py::arg("attachment"), py::arg("texture"), py::arg("level"), py::arg("layer"))
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        .def("attach_texture_layer", [](GL::Framebuffer& self, GL::Framebuffer::BufferAttachment attachment, GL::Texture2DArray& texture, Int level, Int layer) {
+            self.attachTextureLayer(attachment, texture, level, layer);
+            pyObjectHolderFor<GL::PyFramebufferHolder>(self).attachments.emplace_back(pyObjectFromInstance(texture));
+        }, "Attach texture layer to given buffer", py::arg("attachment"), py::arg("texture"), py::arg("level"), py::arg("layer"))
+        #endif
+        ;
 }
 
 }
@@ -25,6 +25,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <chrono>
+#include <thread>
+#include <vector>
 #include <pybind11/pybind11.h>
 
 #include "corrade/EnumOperators.h"
@@ -32,7 +35,99 @@
 
 namespace magnum { namespace platform {
 
+enum class FramePacing: UnsignedByte {
+    OnDemand,
+    Vsync,
+    FrameRateLimit
+};
+
+/* Mouse move / scroll events coalesced during a frame, exposed to Python as a
+   (N, 2) buffer. Valid only during the batch event handler, same as other
+   events. */
+struct MouseMoveBatch {
+    std::vector<Vector2i> positions;
+};
+
+struct MouseScrollBatch {
+    std::vector<Vector2> offsets;
+    Vector2i position;
+};
+
+/* Frame pacing and event batching state, inherited by the publicized
+   application classes */
+struct ApplicationLoopState {
+    FramePacing framePacing{FramePacing::OnDemand};
+    std::chrono::steady_clock::duration framePeriod{std::chrono::microseconds{16667}};
+    std::chrono::steady_clock::time_point nextFrame;
+    bool batchEvents{};
+    MouseMoveBatch mouseMoveBatch;
+    MouseScrollBatch mouseScrollBatch;
+};
+
+/* Called from the trampoline before the Python draw_event() */
+template<class T> void dispatchEventBatches(T& self) {
+    if(!self.mouseMoveBatch.positions.empty()) {
+        if(py::function overload = py::get_overload(static_cast<const T*>(&self), "mouse_move_batch_event"))
+            overload(std::ref(self.mouseMoveBatch));
+        self.mouseMoveBatch.positions.clear();
+    }
+    if(!self.mouseScrollBatch.offsets.empty()) {
+        if(py::function overload = py::get_overload(static_cast<const T*>(&self), "mouse_scroll_batch_event"))
+            overload(std::ref(self.mouseScrollBatch));
+        self.mouseScrollBatch.offsets.clear();
+    }
+}
+
+/* Called from the trampoline after the Python draw_event() */
+template<class T> void paceFrame(T& self) {
+    if(self.framePacing == FramePacing::OnDemand) return;
+
+    self.redraw();
+    if(self.framePacing != FramePacing::FrameRateLimit) return;
+
+    /* If the frame took longer than the period, don't try to catch up */
+    const auto now = std::chrono::steady_clock::now();
+    self.nextFrame += self.framePeriod;
+    if(self.nextFrame < now) {
+        self.nextFrame = now;
+        return;
+    }
+
+    py::gil_scoped_release release;
+    std::this_thread::sleep_until(self.nextFrame);
+}
+
 template<class T, class Trampoline> void application(py::class_<T, Trampoline>& c) {
+    py::enum_<FramePacing>{c, "FramePacing", "Frame pacing policy", py::module_local{}}
+        .value("ON_DEMAND", FramePacing::OnDemand)
+        .value("VSYNC", FramePacing::Vsync)
+        .value("FRAME_RATE_LIMIT", FramePacing::FrameRateLimit);
+
+    py::class_<MouseMoveBatch>{c, "MouseMoveBatch", "Mouse move events coalesced during a frame", py::buffer_protocol{}, py::module_local{}}
+        .def_buffer([](MouseMoveBatch& self) {
+            return py::buffer_info{self.positions.data(), sizeof(Int),
+                py::format_descriptor<Int>::format(), 2,
+                {py::ssize_t(self.positions.size()), py::ssize_t(2)},
+                {py::ssize_t(sizeof(Vector2i)), py::ssize_t(sizeof(Int))}};
+        })
+        .def("__len__", [](MouseMoveBatch& self) {
+            return self.positions.size();
+        }, "Event count");
+
+    py::class_<MouseScrollBatch>{c, "MouseScrollBatch", "Mouse scroll events coalesced during a frame", py::buffer_protocol{}, py::module_local{}}
+        .def_buffer([](MouseScrollBatch& self) {
+            return py::buffer_info{self.offsets.data(), sizeof(Float),
+                py::format_descriptor<Float>::format(), 2,
+                {py::ssize_t(self.offsets.size()), py::ssize_t(2)},
+                {py::ssize_t(sizeof(Vector2)), py::ssize_t(sizeof(Float))}};
+        })
+        .def("__len__", [](MouseScrollBatch& self) {
+            return self.offsets.size();
+        }, "Event count")
+        .def_property_readonly("position", [](MouseScrollBatch& self) {
+            return self.position;
+        }, "Position of the last event");
+
     py::class_<typename T::Configuration> configuration{c, "Configuration", "Configuration"};
     configuration
         .def(py::init())
@@ -67,6 +162,33 @@ template<class T, class Trampoline> void application(py::class_<T, Trampoline>&
         .def("redraw", &T::redraw, "Redraw immediately")
         .def_property_readonly("window_size", &T::windowSize, "Window size")
         .def_property_readonly("framebuffer_size", &T::framebufferSize, "Framebuffer size")
+        .def_property("frame_pacing", [](T& self) {
+            return self.framePacing;
+        }, [](T& self, FramePacing pacing) {
+            if(pacing == FramePacing::Vsync) self.setSwapInterval(1);
+            else if(self.framePacing == FramePacing::Vsync) self.setSwapInterval(0);
+            self.framePacing = pacing;
+            if(pacing != FramePacing::OnDemand) {
+                self.nextFrame = std::chrono::steady_clock::now();
+                self.redraw();
+            }
+        }, "Frame pacing policy")
+        .def_property("frame_period", [](T& self) {
+            return std::chrono::duration<Double>{self.framePeriod}.count();
+        }, [](T& self, Double period) {
+            if(!(period > 0.0)) {
+                PyErr_SetString(PyExc_ValueError, "expected a positive frame period");
+                throw py::error_already_set{};
+            }
+            self.framePeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<Double>{period});
+        }, "Minimal frame period in seconds for a frame rate limit")
+        .def_property("batch_events", [](T& self) {
+            return self.batchEvents;
+        }, [](T& self, bool enabled) {
+            self.batchEvents = enabled;
+            self.mouseMoveBatch.positions.clear();
+            self.mouseScrollBatch.offsets.clear();
+        }, "Coalesce mouse move and scroll events into one call per frame")
 
         /* Event handlers */
         .def("draw_event", &T::drawEvent, "Draw event")
@@ -24,8 +24,18 @@
 */
 
 #include <pybind11/pybind11.h>
+#include <Corrade/Containers/Array.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/Math/Range.h>
 #include <Magnum/Platform/WindowlessEglApplication.h>
 
+#include "Corrade/Python.h"
+#include "Magnum/Python.h"
+
 #include "magnum/bootstrap.h"
 #include "magnum/platform/windowlessapplication.h"
 
@@ -33,6 +43,27 @@ namespace magnum { namespace platform {
 
 namespace {
     int argc = 0;
+
+/* Offscreen color + depth framebuffer with a CPU-side storage the pixels
+   are read into, reused for every render() */
+struct RenderTarget {
+    explicit RenderTarget(const Vector2i& size): framebuffer{{{}, size}}, data{Containers::ValueInit, std::size_t(size.product()*4)} {
+        color.setStorage(GL::RenderbufferFormat::RGBA8, size);
+        #ifndef MAGNUM_TARGET_GLES2
+        depth.setStorage(GL::RenderbufferFormat::DepthComponent24, size);
+        #else
+        depth.setStorage(GL::RenderbufferFormat::DepthComponent16, size);
+        #endif
+        framebuffer
+            .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+            .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, depth);
+    }
+
+    GL::Renderbuffer color, depth;
+    GL::Framebuffer framebuffer;
+    Containers::Array<char> data;
+};
+
 }
 
 void egl(py::module& m) {
@@ -67,6 +98,39 @@ void egl(py::module& m) {
     py::class_<PyWindowlessApplication> windowlessEglApplication{m, "WindowlessApplication", "Windowless EGL application"};
 
     windowlessapplication(windowlessEglApplication);
+
+    py::class_<PyWindowlessContext<Platform::WindowlessEglContext>> windowlessEglContext{m, "WindowlessContext", "Windowless EGL context"};
+
+    windowlesscontext(windowlessEglContext, []() {
+        EGLDisplay display = eglGetCurrentDisplay();
+        if(display != EGL_NO_DISPLAY)
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    });
+
+    py::class_<RenderTarget>{m, "RenderTarget", "Offscreen render target"}
+        .def(py::init([](const Vector2i& size) {
+            if(size.min() <= 0) {
+                PyErr_SetString(PyExc_ValueError, "expected a non-zero size");
+                throw py::error_already_set{};
+            }
+
+            return std::unique_ptr<RenderTarget>{new RenderTarget{size}};
+        }), "Constructor", py::arg("size"))
+        .def_property_readonly("size", [](RenderTarget& self) {
+            return self.framebuffer.viewport().size();
+        }, "Size")
+        .def("render", [](RenderTarget& self, py::function draw) {
+            self.framebuffer
+                .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth)
+                .bind();
+            draw();
+
+            /* Reading into the reused storage, the render target is the
+               memory owner */
+            const MutableImageView2D image{PixelFormat::RGBA8Unorm, self.framebuffer.viewport().size(), self.data};
+            self.framebuffer.read(self.framebuffer.viewport(), image);
+            return pyCastButNotShitty(pyImageViewHolder(image, pyObjectFromInstance(self)));
+        }, "Render into the target and read the pixels back", py::arg("draw"));
 }
 
 }}
@@ -67,6 +67,13 @@ void glx(py::module& m) {
     py::class_<PyWindowlessApplication> windowlessGlxApplication{m, "WindowlessApplication", "Windowless GLX application"};
 
     windowlessapplication(windowlessGlxApplication);
+
+    py::class_<PyWindowlessContext<Platform::WindowlessGlxContext>> windowlessGlxContext{m, "WindowlessContext", "Windowless GLX context"};
+
+    windowlesscontext(windowlessGlxContext, []() {
+        if(Display* display = glXGetCurrentDisplay())
+            glXMakeContextCurrent(display, None, None, nullptr);
+    });
 }
 
 }}
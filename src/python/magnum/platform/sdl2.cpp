@@ -40,7 +40,7 @@ namespace {
 void sdl2(py::module& m) {
     m.doc() = "SDL2-based platform integration";
 
-    struct PublicizedApplication: Platform::Application {
+    struct PublicizedApplication: Platform::Application, ApplicationLoopState {
         explicit PublicizedApplication(const Configuration& configuration, const GLConfiguration& glConfiguration): Platform::Application{Arguments{argc, nullptr}, configuration, glConfiguration} {}
 
         void drawEvent() override {
@@ -64,6 +64,12 @@ void sdl2(py::module& m) {
         using PublicizedApplication::PublicizedApplication;
 
         void drawEvent() override {
+            dispatchEventBatches<PublicizedApplication>(*this);
+            pyDrawEvent();
+            paceFrame(*this);
+        }
+
+        void pyDrawEvent() {
             #ifdef __clang__
             /* ugh pybind don't tell me I AM THE FIRST ON EARTH to get a
                warning here. Why there's no PYBIND11_OVERLOAD_NAME_ARG()
@@ -132,6 +138,12 @@ void sdl2(py::module& m) {
             );
         }
         void mouseMoveEvent(MouseMoveEvent& event) override {
+            if(batchEvents) {
+                mouseMoveBatch.positions.push_back(event.position());
+                redraw();
+                return;
+            }
+
             PYBIND11_OVERLOAD_NAME(
                 void,
                 PublicizedApplication,
@@ -143,6 +155,13 @@ void sdl2(py::module& m) {
             );
         }
         void mouseScrollEvent(MouseScrollEvent& event) override {
+            if(batchEvents) {
+                mouseScrollBatch.offsets.push_back(event.offset());
+                mouseScrollBatch.position = event.position();
+                redraw();
+                return;
+            }
+
             PYBIND11_OVERLOAD_NAME(
                 void,
                 PublicizedApplication,
@@ -24,6 +24,10 @@
 */
 
 #include <pybind11/pybind11.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/Platform/GLContext.h>
+
+#include "Magnum/GL/Python.h"
 
 #include "magnum/bootstrap.h"
 
@@ -46,4 +50,48 @@ template<class T> void windowlessapplication(py::class_<T>& c) {
         ;
 }
 
+/* Windowless context together with a Magnum GL context for it. Unlike the
+   application, any number of these can exist, each made current in a
+   different thread. */
+template<class T> struct PyWindowlessContext {
+    explicit PyWindowlessContext(const typename T::Configuration& configuration): context{configuration}, glContext{NoCreate, 0, nullptr} {}
+
+    T context;
+    Platform::GLContext glContext;
+};
+
+/* The configuration is shared with the application, which has to be bound
+   first. The release function is platform-specific. */
+template<class T> void windowlesscontext(py::class_<PyWindowlessContext<T>>& c, void(*release)()) {
+    c
+        .def(py::init([](const typename T::Configuration& configuration) {
+            std::unique_ptr<PyWindowlessContext<T>> self{new PyWindowlessContext<T>{configuration}};
+            if(!self->context.isCreated() || !self->context.makeCurrent()) {
+                PyErr_SetString(PyExc_RuntimeError, "cannot create a windowless context");
+                throw py::error_already_set{};
+            }
+            if(!self->glContext.tryCreate()) {
+                PyErr_SetString(PyExc_RuntimeError, "cannot initialize a GL context");
+                throw py::error_already_set{};
+            }
+
+            /* The context may reuse an address of a destroyed one, discard
+               renderer statistics state tracked for it */
+            GL::pyHooks().contextCreated();
+
+            return self;
+        }), "Constructor", py::arg("configuration") = typename T::Configuration{})
+        .def("make_current", [](PyWindowlessContext<T>& self) {
+            py::gil_scoped_release release;
+            if(!self.context.makeCurrent()) return false;
+            GL::Context::makeCurrent(&self.glContext);
+            return true;
+        }, "Make the context current in this thread")
+        .def_static("release", [release]() {
+            py::gil_scoped_release r;
+            release();
+            GL::Context::makeCurrent(nullptr);
+        }, "Release the context current in this thread");
+}
+
 }}
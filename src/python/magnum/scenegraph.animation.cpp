@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Magnum/Animation/Player.h>
+#include <Magnum/Math/CubicHermite.h>
+#include <Magnum/SceneGraph/TranslationRotationScalingTransformation3D.h>
+#include <Magnum/Trade/AnimationData.h>
+
+#include "scenegraph.h"
+
+namespace magnum {
+
+namespace {
+
+typedef SceneGraph::Object<SceneGraph::TranslationRotationScalingTransformation3D> Object3D;
+
+/* Player with Python references to the animation data and target objects,
+   to keep them alive for as long as the player points to them */
+struct AnimationPlayer3D: Animation::Player<Float> {
+    std::vector<py::object> references;
+};
+
+void setTranslation(Float, const Vector3& translation, void* object) {
+    static_cast<Object3D*>(object)->setTranslation(translation);
+}
+void setRotation(Float, const Quaternion& rotation, void* object) {
+    static_cast<Object3D*>(object)->setRotation(rotation);
+}
+void setScaling(Float, const Vector3& scaling, void* object) {
+    static_cast<Object3D*>(object)->setScaling(scaling);
+}
+
+void addAnimation(AnimationPlayer3D& self, py::object animationObject, py::sequence objects) {
+    const Trade::AnimationData& animation = py::cast<const Trade::AnimationData&>(animationObject);
+
+    /* Check everything first so a failure doesn't leave the player half-way
+       populated */
+    std::vector<Object3D*> targets(animation.trackCount());
+    std::vector<py::object> references;
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        const Trade::AnimationTrackTargetType targetType = animation.trackTargetType(i);
+        if(targetType != Trade::AnimationTrackTargetType::Translation3D &&
+           targetType != Trade::AnimationTrackTargetType::Rotation3D &&
+           targetType != Trade::AnimationTrackTargetType::Scaling3D)
+            continue;
+
+        const UnsignedInt target = animation.trackTarget(i);
+        if(target >= objects.size()) {
+            PyErr_Format(PyExc_ValueError, "track %u targets object %u but got only %zu objects", i, target, objects.size());
+            throw py::error_already_set{};
+        }
+
+        py::object object = objects[target];
+        if(object.is_none()) continue;
+
+        const Trade::AnimationTrackType type = animation.trackType(i);
+        if(targetType == Trade::AnimationTrackTargetType::Rotation3D ?
+            type != Trade::AnimationTrackType::Quaternion &&
+            type != Trade::AnimationTrackType::CubicHermiteQuaternion :
+            type != Trade::AnimationTrackType::Vector3 &&
+            type != Trade::AnimationTrackType::CubicHermite3D) {
+            PyErr_Format(PyExc_ValueError, "track %u has an unsupported type", i);
+            throw py::error_already_set{};
+        }
+
+        targets[i] = &py::cast<Object3D&>(object);
+        references.push_back(std::move(object));
+    }
+
+    /* The player does a cached keyframe search for each track, so there's no
+       need to remember anything else on our side */
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        if(!targets[i]) continue;
+
+        const Trade::AnimationTrackType type = animation.trackType(i);
+        switch(animation.trackTargetType(i)) {
+            case Trade::AnimationTrackTargetType::Translation3D:
+                if(type == Trade::AnimationTrackType::CubicHermite3D)
+                    self.addWithCallback(animation.track<CubicHermite3D>(i), setTranslation, targets[i]);
+                else
+                    self.addWithCallback(animation.track<Vector3>(i), setTranslation, targets[i]);
+                break;
+            case Trade::AnimationTrackTargetType::Rotation3D:
+                if(type == Trade::AnimationTrackType::CubicHermiteQuaternion)
+                    self.addWithCallback(animation.track<CubicHermiteQuaternion>(i), setRotation, targets[i]);
+                else
+                    self.addWithCallback(animation.track<Quaternion>(i), setRotation, targets[i]);
+                break;
+            case Trade::AnimationTrackTargetType::Scaling3D:
+                if(type == Trade::AnimationTrackType::CubicHermite3D)
+                    self.addWithCallback(animation.track<CubicHermite3D>(i), setScaling, targets[i]);
+                else
+                    self.addWithCallback(animation.track<Vector3>(i), setScaling, targets[i]);
+                break;
+            default: break;
+        }
+    }
+
+    self.references.insert(self.references.end(), references.begin(), references.end());
+    self.references.push_back(std::move(animationObject));
+}
+
+}
+
+void scenegraphAnimation(py::module& m) {
+    /* For the AnimationData type. In a static build these are all in the same
+       module and get registered independently of the order. */
+    #ifndef MAGNUM_BUILD_STATIC
+    py::module::import("magnum.trade");
+    #endif
+
+    py::module trs = m.attr("trs").cast<py::module>();
+
+    py::class_<AnimationPlayer3D> player{trs, "AnimationPlayer3D", "Animation player for three-dimensional TRS objects"};
+
+    py::enum_<Animation::State>{player, "State", "Player state"}
+        .value("STOPPED", Animation::State::Stopped)
+        .value("PLAYING", Animation::State::Playing)
+        .value("PAUSED", Animation::State::Paused);
+
+    player
+        .def(py::init(), "Constructor")
+        .def("add", addAnimation, "Add translation, rotation and scaling tracks of an animation", py::arg("animation"), py::arg("objects"))
+        .def("__len__", &AnimationPlayer3D::size, "Count of tracks managed by this player")
+        .def_property("duration", [](AnimationPlayer3D& self) {
+            return self.duration();
+        }, [](AnimationPlayer3D& self, const Range1D& duration) {
+            self.setDuration(duration);
+        }, "Duration")
+        .def_property("play_count", [](AnimationPlayer3D& self) {
+            return self.playCount();
+        }, [](AnimationPlayer3D& self, UnsignedInt count) {
+            self.setPlayCount(count);
+        }, "Play count")
+        .def_property_readonly("state", [](AnimationPlayer3D& self) {
+            return self.state();
+        }, "State")
+        .def("play", [](AnimationPlayer3D& self, Float startTime) {
+            self.play(startTime);
+        }, "Play", py::arg("start_time"))
+        .def("pause", [](AnimationPlayer3D& self, Float pauseTime) {
+            self.pause(pauseTime);
+        }, "Pause", py::arg("pause_time"))
+        .def("stop", [](AnimationPlayer3D& self) {
+            self.stop();
+        }, "Stop")
+        .def("advance", [](AnimationPlayer3D& self, Float time) {
+            self.advance(time);
+        }, "Advance the animation and update all target objects", py::arg("time"));
+}
+
+}
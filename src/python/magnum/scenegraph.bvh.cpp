@@ -0,0 +1,346 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Matrix4.h>
+
+#include "scenegraph.h"
+
+namespace magnum {
+
+namespace {
+
+/* Bounding volume hierarchy over world-space bounds of drawables in a group.
+   Nodes are stored depth-first, so the left child of an internal node is
+   always right after it and children always come after their parents. That
+   allows refitting the whole tree in a single reverse pass. Python
+   references to the group, the drawables and their objects are kept so the
+   indexed data can't disappear from under the tree. */
+struct DrawableBvh3D {
+    struct Node {
+        Range3D bounds;
+        /* For leafs an offset into the items array, for internal nodes the
+           index of the right child */
+        UnsignedInt offset;
+        /* Zero for internal nodes */
+        UnsignedInt count;
+    };
+
+    explicit DrawableBvh3D(py::object group): group{std::move(group)} {}
+
+    py::object group;
+    std::vector<std::reference_wrapper<PyDrawableBase<3, Float>>> drawables;
+    std::vector<py::object> references;
+    /* World-space bounds of each drawable */
+    std::vector<Range3D> bounds;
+    /* Drawable indices, leafs point to contiguous ranges of these */
+    std::vector<UnsignedInt> items;
+    std::vector<Node> nodes;
+};
+
+constexpr UnsignedInt MaxLeafSize = 4;
+
+/* Transforming the center and the half-size separately gives the tightest
+   axis-aligned box around the transformed box without going through all its
+   eight corners */
+Range3D transformBounds(const Matrix4& transformation, const Range3D& bounds) {
+    const Vector3 center = transformation.transformPoint(bounds.center());
+    const Vector3 halfSize = bounds.size()*0.5f;
+    Vector3 extent;
+    for(std::size_t i = 0; i != 3; ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            extent[i] += Math::abs(transformation[j][i])*halfSize[j];
+    return {center - extent, center + extent};
+}
+
+Range3D join(const Range3D& a, const Range3D& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+void updateBounds(DrawableBvh3D& self) {
+    /* Batch calculation of the transformations if all objects are in the
+       same scene, as that shares the work for common parents. Otherwise
+       calculating each separately. */
+    std::vector<std::reference_wrapper<SceneGraph::AbstractObject3D>> objects;
+    SceneGraph::AbstractObject3D* scene = nullptr;
+    bool sameScene = true;
+    for(PyDrawableBase<3, Float>& drawable: self.drawables) {
+        SceneGraph::AbstractObject3D& object = drawable.object();
+        if(objects.empty()) scene = object.scene();
+        else if(object.scene() != scene) sameScene = false;
+        objects.push_back(object);
+    }
+
+    std::vector<Matrix4> transformations;
+    if(sameScene && scene)
+        transformations = scene->transformationMatrices(objects);
+    else for(SceneGraph::AbstractObject3D& object: objects)
+        transformations.push_back(object.absoluteTransformationMatrix());
+
+    self.bounds.resize(self.drawables.size());
+    for(std::size_t i = 0; i != self.drawables.size(); ++i)
+        self.bounds[i] = transformBounds(transformations[i], self.drawables[i].get().bounds);
+}
+
+/* Splits the items in the middle of the longest axis of their centers,
+   returns index of the created node */
+UnsignedInt buildNode(DrawableBvh3D& self, UnsignedInt begin, UnsignedInt end) {
+    const UnsignedInt index = self.nodes.size();
+    self.nodes.emplace_back();
+
+    Range3D bounds = self.bounds[self.items[begin]];
+    Range3D centers{bounds.center(), bounds.center()};
+    for(UnsignedInt i = begin + 1; i != end; ++i) {
+        const Range3D& itemBounds = self.bounds[self.items[i]];
+        bounds = join(bounds, itemBounds);
+        centers = join(centers, {itemBounds.center(), itemBounds.center()});
+    }
+    self.nodes[index].bounds = bounds;
+
+    if(end - begin <= MaxLeafSize) {
+        self.nodes[index].offset = begin;
+        self.nodes[index].count = end - begin;
+        return index;
+    }
+
+    const Vector3 size = centers.size();
+    const std::size_t axis = size.x() > size.y() ?
+        (size.x() > size.z() ? 0 : 2) :
+        (size.y() > size.z() ? 1 : 2);
+    const UnsignedInt middle = begin + (end - begin)/2;
+    std::nth_element(self.items.begin() + begin, self.items.begin() + middle, self.items.begin() + end, [&self, axis](UnsignedInt a, UnsignedInt b) {
+        return self.bounds[a].center()[axis] < self.bounds[b].center()[axis];
+    });
+
+    buildNode(self, begin, middle);
+    const UnsignedInt right = buildNode(self, middle, end);
+    self.nodes[index].offset = right;
+    self.nodes[index].count = 0;
+    return index;
+}
+
+void rebuild(DrawableBvh3D& self) {
+    auto& group = py::cast<SceneGraph::DrawableGroup3D&>(self.group);
+
+    /* Drawables without bounds are not indexed */
+    self.drawables.clear();
+    self.references.clear();
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        /* Every drawable in a group derives from PyDrawableBase, see its
+           documentation for why the cast is safe */
+        auto& drawable = static_cast<PyDrawableBase<3, Float>&>(group[i]);
+        if(!drawable.hasBounds) continue;
+        self.drawables.push_back(drawable);
+        self.references.push_back(py::cast(&group[i]));
+        self.references.push_back(py::cast(&drawable.object()));
+    }
+
+    updateBounds(self);
+
+    self.items.resize(self.drawables.size());
+    for(std::size_t i = 0; i != self.items.size(); ++i) self.items[i] = i;
+    self.nodes.clear();
+    if(!self.items.empty()) buildNode(self, 0, self.items.size());
+}
+
+void refit(DrawableBvh3D& self) {
+    updateBounds(self);
+
+    for(std::size_t i = self.nodes.size(); i != 0; --i) {
+        DrawableBvh3D::Node& node = self.nodes[i - 1];
+        if(node.count) {
+            node.bounds = self.bounds[self.items[node.offset]];
+            for(UnsignedInt j = 1; j != node.count; ++j)
+                node.bounds = join(node.bounds, self.bounds[self.items[node.offset + j]]);
+        } else node.bounds = join(self.nodes[i].bounds, self.nodes[node.offset].bounds);
+    }
+}
+
+bool intersects(const Range3D& a, const Range3D& b) {
+    return (a.min() <= b.max()).all() && (a.max() >= b.min()).all();
+}
+
+/* Slab test, returns the distance along the ray where it enters the box or
+   infinity if it misses it */
+Float rayDistance(const Range3D& bounds, const Vector3& origin, const Vector3& inverseDirection) {
+    Float entry = 0.0f;
+    Float exit = std::numeric_limits<Float>::infinity();
+    for(std::size_t i = 0; i != 3; ++i) {
+        Float a = (bounds.min()[i] - origin[i])*inverseDirection[i];
+        Float b = (bounds.max()[i] - origin[i])*inverseDirection[i];
+        if(a > b) std::swap(a, b);
+        /* NaN happens when the origin lies on a slab with the direction
+           parallel to it, treat that as inside the slab */
+        if(!Math::isNan(a)) entry = Math::max(entry, a);
+        if(!Math::isNan(b)) exit = Math::min(exit, b);
+        if(entry > exit) return std::numeric_limits<Float>::infinity();
+    }
+    return entry;
+}
+
+Float pointDistanceSquared(const Range3D& bounds, const Vector3& point) {
+    return Math::max(Math::max(bounds.min() - point, point - bounds.max()), Vector3{0.0f}).dot();
+}
+
+py::object itemObject(DrawableBvh3D& self, UnsignedInt item) {
+    return py::cast(&self.drawables[item].get().object());
+}
+
+py::list rayQuery(DrawableBvh3D& self, const Vector3& origin, const Vector3& direction) {
+    const Vector3 inverseDirection = 1.0f/direction;
+    std::vector<std::pair<Float, UnsignedInt>> hits;
+    std::vector<UnsignedInt> stack;
+    if(!self.nodes.empty()) stack.push_back(0);
+    while(!stack.empty()) {
+        const DrawableBvh3D::Node& node = self.nodes[stack.back()];
+        const UnsignedInt index = stack.back();
+        stack.pop_back();
+        if(rayDistance(node.bounds, origin, inverseDirection) == std::numeric_limits<Float>::infinity())
+            continue;
+
+        if(!node.count) {
+            stack.push_back(node.offset);
+            stack.push_back(index + 1);
+            continue;
+        }
+
+        for(UnsignedInt i = node.offset; i != node.offset + node.count; ++i) {
+            const Float distance = rayDistance(self.bounds[self.items[i]], origin, inverseDirection);
+            if(distance != std::numeric_limits<Float>::infinity())
+                hits.emplace_back(distance, self.items[i]);
+        }
+    }
+
+    /* Stable so items at the same distance keep the order in the group */
+    std::stable_sort(hits.begin(), hits.end(), [](const std::pair<Float, UnsignedInt>& a, const std::pair<Float, UnsignedInt>& b) {
+        return a.first < b.first;
+    });
+
+    py::list out;
+    for(const std::pair<Float, UnsignedInt>& hit: hits)
+        out.append(itemObject(self, hit.second));
+    return out;
+}
+
+py::list rangeQuery(DrawableBvh3D& self, const Range3D& range) {
+    std::vector<UnsignedInt> found;
+    std::vector<UnsignedInt> stack;
+    if(!self.nodes.empty()) stack.push_back(0);
+    while(!stack.empty()) {
+        const DrawableBvh3D::Node& node = self.nodes[stack.back()];
+        const UnsignedInt index = stack.back();
+        stack.pop_back();
+        if(!intersects(node.bounds, range)) continue;
+
+        if(!node.count) {
+            stack.push_back(node.offset);
+            stack.push_back(index + 1);
+            continue;
+        }
+
+        for(UnsignedInt i = node.offset; i != node.offset + node.count; ++i)
+            if(intersects(self.bounds[self.items[i]], range))
+                found.push_back(self.items[i]);
+    }
+
+    /* Report in the order of the group, not the tree */
+    std::sort(found.begin(), found.end());
+
+    py::list out;
+    for(UnsignedInt item: found)
+        out.append(itemObject(self, item));
+    return out;
+}
+
+py::list nearest(DrawableBvh3D& self, const Vector3& point, std::size_t count) {
+    /* Best-first search over both nodes and items. A node is never further
+       than anything inside it, so once an item gets to the top of the queue,
+       nothing closer can come after it. */
+    struct Entry {
+        Float distance;
+        bool isItem;
+        UnsignedInt index;
+
+        bool operator<(const Entry& other) const {
+            return distance > other.distance;
+        }
+    };
+    std::priority_queue<Entry> queue;
+    if(!self.nodes.empty())
+        queue.push({pointDistanceSquared(self.nodes[0].bounds, point), false, 0});
+
+    py::list out;
+    while(!queue.empty() && out.size() < count) {
+        const Entry entry = queue.top();
+        queue.pop();
+
+        if(entry.isItem) {
+            out.append(itemObject(self, entry.index));
+            continue;
+        }
+
+        const DrawableBvh3D::Node& node = self.nodes[entry.index];
+        if(!node.count) {
+            queue.push({pointDistanceSquared(self.nodes[entry.index + 1].bounds, point), false, entry.index + 1});
+            queue.push({pointDistanceSquared(self.nodes[node.offset].bounds, point), false, node.offset});
+        } else for(UnsignedInt i = node.offset; i != node.offset + node.count; ++i)
+            queue.push({pointDistanceSquared(self.bounds[self.items[i]], point), true, self.items[i]});
+    }
+
+    return out;
+}
+
+}
+
+void scenegraphBvh(py::module& m) {
+    py::class_<DrawableBvh3D>{m, "DrawableBvh3D", "Bounding volume hierarchy over three-dimensional drawables"}
+        .def(py::init([](py::object drawables) {
+            /* Checks the type */
+            py::cast<SceneGraph::DrawableGroup3D&>(drawables);
+            auto self = new DrawableBvh3D{std::move(drawables)};
+            rebuild(*self);
+            return self;
+        }), "Constructor", py::arg("drawables"))
+        .def("__len__", [](DrawableBvh3D& self) {
+            return self.drawables.size();
+        }, "Count of indexed drawables")
+        .def_property_readonly("drawables", [](DrawableBvh3D& self) {
+            return self.group;
+        }, "Drawable group")
+        .def_property_readonly("bounds", [](DrawableBvh3D& self) -> py::object {
+            if(self.nodes.empty()) return py::none{};
+            return py::cast(self.nodes[0].bounds);
+        }, "World-space bounds of all indexed drawables or None if empty")
+        .def("rebuild", rebuild, "Rebuild the hierarchy from drawables currently in the group")
+        .def("refit", refit, "Update bounds after object transformations changed")
+        .def("ray_query", rayQuery, "Objects with bounds intersected by a ray, nearest first", py::arg("origin"), py::arg("direction"))
+        .def("range_query", rangeQuery, "Objects with bounds intersecting a range", py::arg("range"))
+        .def("nearest", nearest, "Objects with bounds nearest to a point", py::arg("point"), py::arg("count") = 1);
+}
+
+}
@@ -23,19 +23,37 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <pybind11/pybind11.h>
+#include <Magnum/Math/Matrix4.h>
 #include <Magnum/SceneGraph/Camera.h>
-#include <Magnum/SceneGraph/Drawable.h>
 #include <Magnum/SceneGraph/AbstractObject.h>
+/* The SceneGraph library has only the float variants compiled in, the double
+   ones get instantiated from the template implementations here */
+#include <Magnum/SceneGraph/AbstractFeature.hpp>
+#include <Magnum/SceneGraph/Camera.hpp>
+#include <Magnum/SceneGraph/Drawable.hpp>
+#include <Magnum/SceneGraph/FeatureGroup.hpp>
 
 #include "magnum/scenegraph.h"
 
+#ifdef MAGNUM_BUILD_STATIC
+#include "magnum/staticconfigure.h"
+#endif
+
 namespace magnum {
 
 namespace {
 
-template<UnsignedInt dimensions, class T> struct PyDrawable: SceneGraph::PyFeature<SceneGraph::Drawable<dimensions, T>> {
-    explicit PyDrawable(SceneGraph::AbstractObject<dimensions, T>& object, SceneGraph::DrawableGroup<dimensions, T>* drawables): SceneGraph::PyFeature<SceneGraph::Drawable<dimensions, T>>{object, drawables} {}
+enum class DrawOrder: UnsignedByte {
+    Unsorted,
+    FrontToBack,
+    BackToFront,
+    SortKey
+};
+
+template<UnsignedInt dimensions, class T> struct PyDrawable: PyDrawableBase<dimensions, T> {
+    explicit PyDrawable(SceneGraph::AbstractObject<dimensions, T>& object, SceneGraph::DrawableGroup<dimensions, T>* drawables): PyDrawableBase<dimensions, T>{object, drawables} {}
 
     void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, SceneGraph::Camera<dimensions, T>& camera) override {
         PYBIND11_OVERLOAD_PURE_NAME(
@@ -49,16 +67,101 @@ template<UnsignedInt dimensions, class T> struct PyDrawable: SceneGraph::PyFeatu
     }
 };
 
+/* Feature caching the absolute transformation of its object. Recalculated
+   only when the object or any of its parents changed since the last query. */
+template<UnsignedInt dimensions, class T> struct CachedTransformation: SceneGraph::PyFeature<SceneGraph::AbstractFeature<dimensions, T>> {
+    explicit CachedTransformation(SceneGraph::AbstractObject<dimensions, T>& object): SceneGraph::PyFeature<SceneGraph::AbstractFeature<dimensions, T>>{object} {
+        this->setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
+        /* The object might be clean already, in which case clean() wouldn't
+           get called for this feature */
+        object.setDirty();
+    }
+
+    void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override {
+        matrix = absoluteTransformationMatrix;
+    }
+
+    MatrixTypeFor<dimensions, T> matrix;
+};
+
+/* A box is outside of the view if all its corners are outside of the same
+   clip plane. Works for both 2D and 3D, in 2D there's just no near / far. */
+template<UnsignedInt dimensions, class T> bool isVisible(const Math::Range<dimensions, T>& bounds, const MatrixTypeFor<dimensions, T>& transformationProjection) {
+    for(std::size_t plane = 0; plane != dimensions*2; ++plane) {
+        bool outside = true;
+        for(std::size_t corner = 0; corner != 1 << dimensions && outside; ++corner) {
+            Math::Vector<dimensions + 1, T> point{T(1)};
+            for(std::size_t i = 0; i != dimensions; ++i)
+                point[i] = (corner & (1 << i)) ? bounds.max()[i] : bounds.min()[i];
+            const Math::Vector<dimensions + 1, T> clip = transformationProjection*point;
+            const T w = clip[dimensions];
+            if(plane % 2 ? clip[plane/2] <= w : clip[plane/2] >= -w)
+                outside = false;
+        }
+        if(outside) return false;
+    }
+
+    return true;
+}
+
+/* Distance from the camera, which looks in the direction of -Z. There's no
+   depth in 2D. */
+template<class T> T viewDepth(const Math::Matrix3<T>&) { return T(0); }
+template<class T> T viewDepth(const Math::Matrix4<T>& transformation) {
+    return -transformation.translation().z();
+}
+
+template<UnsignedInt dimensions, class T> void cameraDraw(SceneGraph::Camera<dimensions, T>& camera, SceneGraph::DrawableGroup<dimensions, T>& drawables, bool cull, DrawOrder order) {
+    if(!cull && order == DrawOrder::Unsorted) {
+        camera.draw(drawables);
+        return;
+    }
+
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> transformations = camera.drawableTransformations(drawables);
+
+    /* Every drawable in a group derives from PyDrawableBase, see its
+       documentation for why the static_casts below are safe */
+    if(cull) transformations.erase(std::remove_if(transformations.begin(), transformations.end(), [&camera](const std::pair<std::reference_wrapper<SceneGraph::Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>& a) {
+        auto& drawable = static_cast<PyDrawableBase<dimensions, T>&>(a.first.get());
+        return drawable.hasBounds && !isVisible(drawable.bounds, camera.projectionMatrix()*a.second);
+    }), transformations.end());
+
+    /* Stable so drawables with equal keys keep the order in the group */
+    if(order == DrawOrder::FrontToBack || order == DrawOrder::BackToFront) {
+        const bool frontToBack = order == DrawOrder::FrontToBack;
+        std::stable_sort(transformations.begin(), transformations.end(), [frontToBack](const std::pair<std::reference_wrapper<SceneGraph::Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>& a, const std::pair<std::reference_wrapper<SceneGraph::Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>& b) {
+            return frontToBack ?
+                viewDepth(a.second) < viewDepth(b.second) :
+                viewDepth(a.second) > viewDepth(b.second);
+        });
+    } else if(order == DrawOrder::SortKey) {
+        std::stable_sort(transformations.begin(), transformations.end(), [](const std::pair<std::reference_wrapper<SceneGraph::Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>& a, const std::pair<std::reference_wrapper<SceneGraph::Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>& b) {
+            return static_cast<PyDrawableBase<dimensions, T>&>(a.first.get()).sortKey <
+                   static_cast<PyDrawableBase<dimensions, T>&>(b.first.get()).sortKey;
+        });
+    }
+
+    camera.draw(transformations);
+}
+
 template<UnsignedInt dimensions, class T> void abstractObject(py::class_<SceneGraph::AbstractObject<dimensions, T>, SceneGraph::PyObjectHolder<SceneGraph::AbstractObject<dimensions, T>>>& c) {
     c
         /* Matrix transformation APIs */
         .def("transformation_matrix", &SceneGraph::AbstractObject<dimensions, T>::transformationMatrix,
             "Transformation matrix")
         .def("absolute_transformation_matrix", &SceneGraph::AbstractObject<dimensions, T>::absoluteTransformationMatrix,
-             "Transformation matrix relative to the root object");
+             "Transformation matrix relative to the root object")
+
+        /* Caching */
+        .def_property_readonly("is_dirty", &SceneGraph::AbstractObject<dimensions, T>::isDirty,
+            "Whether absolute transformation is dirty")
+        .def("set_dirty", &SceneGraph::AbstractObject<dimensions, T>::setDirty,
+            "Set object absolute transformation as dirty")
+        .def("set_clean", static_cast<void(SceneGraph::AbstractObject<dimensions, T>::*)()>(&SceneGraph::AbstractObject<dimensions, T>::setClean),
+            "Clean object absolute transformation");
 }
 
-template<class PyFeature, UnsignedInt dimensions, class Feature, class T> void featureGroup(py::class_<SceneGraph::FeatureGroup<dimensions, Feature, T>>& c) {
+template<UnsignedInt dimensions, class Feature, class T> void featureGroup(py::class_<SceneGraph::FeatureGroup<dimensions, Feature, T>>& c) {
     c
         .def(py::init(), "Constructor")
         .def("__len__", &SceneGraph::FeatureGroup<dimensions, Feature, T>::size,
@@ -66,18 +169,20 @@ template<class PyFeature, UnsignedInt dimensions, class Feature, class T> void f
         /* Get item. Fetching the already registered instance and returning
            that instead of wrapping the pointer again. Need to raise IndexError
            in order to allow iteration: https://docs.python.org/3/reference/datamodel.html#object.__getitem__ */
-        .def("__getitem__", [](SceneGraph::FeatureGroup<dimensions, Feature, T>& self, std::size_t index) -> PyFeature& {
+        .def("__getitem__", [](SceneGraph::FeatureGroup<dimensions, Feature, T>& self, std::size_t index) -> Feature& {
             if(index >= self.size())  {
                 PyErr_SetNone(PyExc_IndexError);
                 throw py::error_already_set{};
             }
-            return static_cast<PyFeature&>(self[index]);
+            /* Features are polymorphic, so this finds the registered
+               instance of whatever the concrete type is */
+            return self[index];
         }, "Feature at given index")
-        .def("add", [](SceneGraph::FeatureGroup<dimensions, Feature, T>& self, PyFeature& feature) {
+        .def("add", [](SceneGraph::FeatureGroup<dimensions, Feature, T>& self, Feature& feature) {
             self.add(feature);
         }, "Add a feature to the group")
-        .def("remove", [](SceneGraph::FeatureGroup<dimensions, Feature, T>& self, PyFeature& feature) {
-            self.add(feature);
+        .def("remove", [](SceneGraph::FeatureGroup<dimensions, Feature, T>& self, Feature& feature) {
+            self.remove(feature);
         }, "Remove a feature from the group");
 }
 
@@ -90,14 +195,41 @@ template<UnsignedInt dimensions, class T> void feature(py::class_<SceneGraph::Ab
         }, "Object holding this feature");
 }
 
+template<UnsignedInt dimensions, class T> void cachedTransformation(py::class_<CachedTransformation<dimensions, T>, SceneGraph::AbstractFeature<dimensions, T>, SceneGraph::PyFeatureHolder<CachedTransformation<dimensions, T>>>& c) {
+    c
+        .def(py::init<SceneGraph::AbstractObject<dimensions, T>&>(),
+            "Constructor", py::arg("object"))
+        .def_property_readonly("absolute_transformation_matrix", [](CachedTransformation<dimensions, T>& self) {
+            if(self.object().isDirty()) self.object().setClean();
+            return self.matrix;
+        }, "Cached transformation matrix relative to the root object");
+}
+
 template<UnsignedInt dimensions, class T> void drawable(py::class_<SceneGraph::Drawable<dimensions, T>, SceneGraph::AbstractFeature<dimensions, T>, PyDrawable<dimensions, T>, SceneGraph::PyFeatureHolder<SceneGraph::Drawable<dimensions, T>>>& c) {
     c
         .def(py::init_alias<SceneGraph::AbstractObject<dimensions, T>&, SceneGraph::DrawableGroup<dimensions, T>*>(),
             "Constructor", py::arg("object"), py::arg("drawables") = nullptr)
-        .def_property_readonly("drawables", [](PyDrawable<dimensions, T>& self) {
+        .def_property_readonly("drawables", [](SceneGraph::Drawable<dimensions, T>& self) {
             return self.drawables();
         }, "Group containing this drawable")
-        .def("draw", [](PyDrawable<dimensions, T>& self, const MatrixTypeFor<dimensions, T>& transformationMatrix, SceneGraph::Camera<dimensions, T>& camera) {
+        /* All drawables created from Python derive from PyDrawableBase, be it
+           the PyDrawable trampoline or the native drawables, so the casts are
+           safe. See PyDrawableBase for details. */
+        .def_property("bounds", [](SceneGraph::Drawable<dimensions, T>& self) -> py::object {
+            auto& base = static_cast<PyDrawableBase<dimensions, T>&>(self);
+            if(!base.hasBounds) return py::none{};
+            return py::cast(base.bounds);
+        }, [](SceneGraph::Drawable<dimensions, T>& self, py::object bounds) {
+            auto& base = static_cast<PyDrawableBase<dimensions, T>&>(self);
+            base.hasBounds = !bounds.is_none();
+            if(base.hasBounds) base.bounds = py::cast<typename DimensionTraits<dimensions, T>::RangeType>(bounds);
+        }, "Bounds in object-local space used for culling or None")
+        .def_property("sort_key", [](SceneGraph::Drawable<dimensions, T>& self) {
+            return static_cast<PyDrawableBase<dimensions, T>&>(self).sortKey;
+        }, [](SceneGraph::Drawable<dimensions, T>& self, Long key) {
+            static_cast<PyDrawableBase<dimensions, T>&>(self).sortKey = key;
+        }, "Key used for sorting when drawing")
+        .def("draw", [](SceneGraph::Drawable<dimensions, T>& self, const MatrixTypeFor<dimensions, T>& transformationMatrix, SceneGraph::Camera<dimensions, T>& camera) {
             self.draw(transformationMatrix, camera);
         }, "Draw the object using given camera", py::arg("transformation_matrix"), py::arg("camera"));
 }
@@ -123,8 +255,8 @@ template<UnsignedInt dimensions, class T> void camera(py::class_<SceneGraph::Cam
         .def_property("viewport", &SceneGraph::Camera<dimensions, T>::viewport,
             &SceneGraph::Camera<dimensions, T>::setViewport,
             "Viewport size")
-        .def("draw", static_cast<void(SceneGraph::Camera<dimensions, T>::*)(SceneGraph::DrawableGroup<dimensions, T>&)>(&SceneGraph::Camera<dimensions, T>::draw),
-            "Draw");
+        .def("draw", cameraDraw<dimensions, T>,
+            "Draw", py::arg("drawables"), py::arg("cull") = false, py::arg("order") = DrawOrder::Unsorted);
 }
 
 }
@@ -132,17 +264,34 @@ template<UnsignedInt dimensions, class T> void camera(py::class_<SceneGraph::Cam
 void scenegraph(py::module& m) {
     m.doc() = "Scene graph library";
 
+    /* Returned from the batch transformation queries. The private function
+       is for tests to verify such output is accepted back without a copy. */
+    arrayOutputType(m);
+    m.def("_is_matrix4_array_view", [](py::handle array) {
+        return ArrayInput<Matrix4>{array}.isView();
+    });
+
     /* Abstract objects. Returned from feature.object, so need to be registered
        as well. */
     {
         py::class_<SceneGraph::AbstractObject2D, SceneGraph::PyObjectHolder<SceneGraph::AbstractObject2D>> abstractObject2D{m, "AbstractObject2D", "Base object for two-dimensional scenes"};
         py::class_<SceneGraph::AbstractObject3D, SceneGraph::PyObjectHolder<SceneGraph::AbstractObject3D>> abstractObject3D{m, "AbstractObject3D", "Base object for three-dimensional scenes"};
+        py::class_<SceneGraph::AbstractObject<2, Double>, SceneGraph::PyObjectHolder<SceneGraph::AbstractObject<2, Double>>> abstractObject2Dd{m, "AbstractObject2Dd", "Base object for two-dimensional double scenes"};
+        py::class_<SceneGraph::AbstractObject<3, Double>, SceneGraph::PyObjectHolder<SceneGraph::AbstractObject<3, Double>>> abstractObject3Dd{m, "AbstractObject3Dd", "Base object for three-dimensional double scenes"};
         abstractObject(abstractObject2D);
         abstractObject(abstractObject3D);
+        abstractObject(abstractObject2Dd);
+        abstractObject(abstractObject3Dd);
     }
 
     /* Drawables, camera */
     {
+        py::enum_<DrawOrder>{m, "DrawOrder", "Camera draw order"}
+            .value("UNSORTED", DrawOrder::Unsorted)
+            .value("FRONT_TO_BACK", DrawOrder::FrontToBack)
+            .value("BACK_TO_FRONT", DrawOrder::BackToFront)
+            .value("SORT_KEY", DrawOrder::SortKey);
+
         py::enum_<SceneGraph::AspectRatioPolicy>{m, "AspectRatioPolicy", "Camera aspect ratio policy"}
             .value("NOT_PRESERVED", SceneGraph::AspectRatioPolicy::NotPreserved)
             .value("EXTEND", SceneGraph::AspectRatioPolicy::Extend)
@@ -156,14 +305,19 @@ void scenegraph(py::module& m) {
         feature(feature2D);
         feature(feature3D);
 
+        py::class_<CachedTransformation<2, Float>, SceneGraph::AbstractFeature2D, SceneGraph::PyFeatureHolder<CachedTransformation<2, Float>>> cachedTransformation2D{m, "CachedTransformation2D", "Cached absolute transformation for two-dimensional float objects"};
+        py::class_<CachedTransformation<3, Float>, SceneGraph::AbstractFeature3D, SceneGraph::PyFeatureHolder<CachedTransformation<3, Float>>> cachedTransformation3D{m, "CachedTransformation3D", "Cached absolute transformation for three-dimensional float objects"};
+        cachedTransformation(cachedTransformation2D);
+        cachedTransformation(cachedTransformation3D);
+
         py::class_<SceneGraph::Drawable2D, SceneGraph::AbstractFeature2D, PyDrawable<2, Float>, SceneGraph::PyFeatureHolder<SceneGraph::Drawable2D>> drawable2D{m, "Drawable2D", "Drawable for two-dimensional float scenes"};
         py::class_<SceneGraph::Drawable3D, SceneGraph::AbstractFeature3D, PyDrawable<3, Float>, SceneGraph::PyFeatureHolder<SceneGraph::Drawable3D>> drawable3D{m, "Drawable3D", "Drawable for three-dimensional float scenes"};
 
         py::class_<SceneGraph::Camera2D, SceneGraph::AbstractFeature2D, SceneGraph::PyFeature<SceneGraph::Camera2D>, SceneGraph::PyFeatureHolder<SceneGraph::Camera2D>> camera2D{m, "Camera2D", "Camera for two-dimensional float scenes"};
         py::class_<SceneGraph::Camera3D, SceneGraph::AbstractFeature3D, SceneGraph::PyFeature<SceneGraph::Camera3D>, SceneGraph::PyFeatureHolder<SceneGraph::Camera3D>> camera3D{m, "Camera3D", "Camera for three-dimensional float scenes"};
 
-        featureGroup<PyDrawable<2, Float>>(drawableGroup2D);
-        featureGroup<PyDrawable<3, Float>>(drawableGroup3D);
+        featureGroup(drawableGroup2D);
+        featureGroup(drawableGroup3D);
         drawable(drawable2D);
         drawable(drawable3D);
 
@@ -171,9 +325,57 @@ void scenegraph(py::module& m) {
         camera(camera3D);
     }
 
+    /* Double variants of the above, for scenes where float precision isn't
+       enough. Camera.draw() calculates the drawable transformations relative
+       to the camera, so drawables get small values even in huge scenes. */
+    {
+        py::class_<SceneGraph::DrawableGroup<2, Double>> drawableGroup2Dd{m, "DrawableGroup2Dd", "Group of drawables for two-dimensional double scenes"};
+        py::class_<SceneGraph::DrawableGroup<3, Double>> drawableGroup3Dd{m, "DrawableGroup3Dd", "Group of drawables for three-dimensional double scenes"};
+
+        py::class_<SceneGraph::AbstractFeature<2, Double>, SceneGraph::PyFeature<SceneGraph::AbstractFeature<2, Double>>, SceneGraph::PyFeatureHolder<SceneGraph::AbstractFeature<2, Double>>> feature2Dd{m, "AbstractFeature2Dd", "Base for two-dimensional double features"};
+        py::class_<SceneGraph::AbstractFeature<3, Double>, SceneGraph::PyFeature<SceneGraph::AbstractFeature<3, Double>>, SceneGraph::PyFeatureHolder<SceneGraph::AbstractFeature<3, Double>>> feature3Dd{m, "AbstractFeature3Dd", "Base for three-dimensional double features"};
+        feature(feature2Dd);
+        feature(feature3Dd);
+
+        py::class_<CachedTransformation<2, Double>, SceneGraph::AbstractFeature<2, Double>, SceneGraph::PyFeatureHolder<CachedTransformation<2, Double>>> cachedTransformation2Dd{m, "CachedTransformation2Dd", "Cached absolute transformation for two-dimensional double objects"};
+        py::class_<CachedTransformation<3, Double>, SceneGraph::AbstractFeature<3, Double>, SceneGraph::PyFeatureHolder<CachedTransformation<3, Double>>> cachedTransformation3Dd{m, "CachedTransformation3Dd", "Cached absolute transformation for three-dimensional double objects"};
+        cachedTransformation(cachedTransformation2Dd);
+        cachedTransformation(cachedTransformation3Dd);
+
+        py::class_<SceneGraph::Drawable<2, Double>, SceneGraph::AbstractFeature<2, Double>, PyDrawable<2, Double>, SceneGraph::PyFeatureHolder<SceneGraph::Drawable<2, Double>>> drawable2Dd{m, "Drawable2Dd", "Drawable for two-dimensional double scenes"};
+        py::class_<SceneGraph::Drawable<3, Double>, SceneGraph::AbstractFeature<3, Double>, PyDrawable<3, Double>, SceneGraph::PyFeatureHolder<SceneGraph::Drawable<3, Double>>> drawable3Dd{m, "Drawable3Dd", "Drawable for three-dimensional double scenes"};
+
+        py::class_<SceneGraph::Camera<2, Double>, SceneGraph::AbstractFeature<2, Double>, SceneGraph::PyFeature<SceneGraph::Camera<2, Double>>, SceneGraph::PyFeatureHolder<SceneGraph::Camera<2, Double>>> camera2Dd{m, "Camera2Dd", "Camera for two-dimensional double scenes"};
+        py::class_<SceneGraph::Camera<3, Double>, SceneGraph::AbstractFeature<3, Double>, SceneGraph::PyFeature<SceneGraph::Camera<3, Double>>, SceneGraph::PyFeatureHolder<SceneGraph::Camera<3, Double>>> camera3Dd{m, "Camera3Dd", "Camera for three-dimensional double scenes"};
+
+        featureGroup(drawableGroup2Dd);
+        featureGroup(drawableGroup3Dd);
+        drawable(drawable2Dd);
+        drawable(drawable3Dd);
+
+        camera(camera2Dd);
+        camera(camera3Dd);
+    }
+
     /* Concrete transformation implementations */
     magnum::scenegraphMatrix(m);
     magnum::scenegraphTrs(m);
+
+    /* Data-oriented alternative to the above */
+    magnum::scenegraphFlat(m);
+
+    /* Spatial queries on drawables */
+    magnum::scenegraphBvh(m);
+
+    /* Native drawables, available only if the Shaders library is */
+    #ifdef Magnum_Shaders_FOUND
+    magnum::scenegraphDrawables(m);
+    #endif
+
+    /* Animation player, available only if the Trade library is */
+    #ifdef Magnum_Trade_FOUND
+    magnum::scenegraphAnimation(m);
+    #endif
 }
 
 }
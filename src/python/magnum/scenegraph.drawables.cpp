@@ -0,0 +1,120 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/SceneGraph/Camera.h>
+#include <Magnum/SceneGraph/Camera.hpp>
+#include <Magnum/SceneGraph/Drawable.hpp>
+#include <Magnum/Shaders/Flat.h>
+#include <Magnum/Shaders/Phong.h>
+
+#include "Magnum/GL/Python.h"
+
+#include "scenegraph.h"
+
+namespace magnum {
+
+namespace {
+
+/* Drawable drawing a mesh with a builtin shader directly from C++, so
+   Camera.draw() doesn't need to call into Python for it. Python references
+   to the mesh and shader are kept to ensure they stay alive. In double
+   scenes the transformation passed to draw() is already relative to the
+   camera, so it's cast to floats only after the large world-space
+   translations cancelled out. */
+template<class T> struct MeshDrawable3D: PyDrawableBase<3, T> {
+    explicit MeshDrawable3D(SceneGraph::AbstractObject<3, T>& object, SceneGraph::DrawableGroup<3, T>* drawables, py::object mesh, py::object shader, const Color4& color): PyDrawableBase<3, T>{object, drawables}, meshObject{std::move(mesh)}, shaderObject{std::move(shader)}, color{color} {
+        this->mesh = &py::cast<GL::Mesh&>(meshObject);
+        if(py::isinstance<Shaders::Flat3D>(shaderObject))
+            flat = &py::cast<Shaders::Flat3D&>(shaderObject);
+        else if(py::isinstance<Shaders::Phong>(shaderObject))
+            phong = &py::cast<Shaders::Phong&>(shaderObject);
+        else {
+            PyErr_Format(PyExc_TypeError, "expected Flat3D or Phong, got %A", shaderObject.get_type().ptr());
+            throw py::error_already_set{};
+        }
+    }
+
+    void draw(const Math::Matrix4<T>& transformationMatrix, SceneGraph::Camera<3, T>& camera) override {
+        const Matrix4 transformation{transformationMatrix};
+        const Matrix4 projection{camera.projectionMatrix()};
+        /* Same link check and statistics as AbstractShaderProgram.draw()
+           does, a failure propagates out of Camera.draw() */
+        GL::pyHooks().draw(flat ? static_cast<GL::AbstractShaderProgram&>(*flat) : *phong, 1);
+        if(flat) flat
+            ->setTransformationProjectionMatrix(projection*transformation)
+            .setColor(color)
+            .draw(*mesh);
+        else phong
+            ->setTransformationMatrix(transformation)
+            .setNormalMatrix(transformation.normalMatrix())
+            .setProjectionMatrix(projection)
+            .setDiffuseColor(color)
+            .draw(*mesh);
+    }
+
+    py::object meshObject, shaderObject;
+    GL::Mesh* mesh;
+    Shaders::Flat3D* flat{};
+    Shaders::Phong* phong{};
+    Color4 color;
+};
+
+template<class T> void meshDrawable(py::class_<MeshDrawable3D<T>, SceneGraph::Drawable<3, T>, SceneGraph::PyFeatureHolder<MeshDrawable3D<T>>>& c) {
+    c
+        .def(py::init([](SceneGraph::AbstractObject<3, T>& object, SceneGraph::DrawableGroup<3, T>* drawables, py::object mesh, py::object shader, const Color4& color) {
+            return new MeshDrawable3D<T>{object, drawables, std::move(mesh), std::move(shader), color};
+        }), "Constructor", py::arg("object"), py::arg("drawables"), py::arg("mesh"), py::arg("shader"), py::arg("color") = Color4{1.0f})
+        .def_property_readonly("mesh", [](MeshDrawable3D<T>& self) {
+            return self.meshObject;
+        }, "Mesh")
+        .def_property_readonly("shader", [](MeshDrawable3D<T>& self) {
+            return self.shaderObject;
+        }, "Shader")
+        .def_property("color", [](MeshDrawable3D<T>& self) {
+            return self.color;
+        }, [](MeshDrawable3D<T>& self, const Color4& color) {
+            self.color = color;
+        }, "Color");
+}
+
+}
+
+void scenegraphDrawables(py::module& m) {
+    /* For the mesh and shader types. In a static build these are all in the
+       same module and get registered independently of the order. */
+    #ifndef MAGNUM_BUILD_STATIC
+    py::module::import("magnum.shaders");
+    #endif
+
+    py::class_<MeshDrawable3D<Float>, SceneGraph::Drawable3D, SceneGraph::PyFeatureHolder<MeshDrawable3D<Float>>> meshDrawable3D{m, "MeshDrawable3D", "Native drawable for three-dimensional float scenes"};
+    py::class_<MeshDrawable3D<Double>, SceneGraph::Drawable<3, Double>, SceneGraph::PyFeatureHolder<MeshDrawable3D<Double>>> meshDrawable3Dd{m, "MeshDrawable3Dd", "Native drawable for three-dimensional double scenes"};
+    meshDrawable(meshDrawable3D);
+    meshDrawable(meshDrawable3Dd);
+}
+
+}
@@ -0,0 +1,260 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Quaternion.h>
+
+#include "scenegraph.h"
+
+namespace magnum {
+
+namespace {
+
+/* Scene stored as a structure of arrays, with parents always before their
+   children so world transformations can be calculated in a single linear
+   pass. Each array is a bytearray that's handed out to Python through
+   arrayOutputView(), in the same layout as other array outputs, which also
+   means Python itself prevents the arrays from being resized while some
+   view on them still exists. */
+struct FlatScene3D {
+    explicit FlatScene3D() {
+        for(py::object* array: {&parents, &translations, &rotations, &scalings, &worldMatrices}) {
+            *array = py::reinterpret_steal<py::object>(PyByteArray_FromStringAndSize(nullptr, 0));
+            if(!*array) throw py::error_already_set{};
+        }
+    }
+
+    Int* parentData() { return reinterpret_cast<Int*>(PyByteArray_AS_STRING(parents.ptr())); }
+    Vector3* translationData() { return reinterpret_cast<Vector3*>(PyByteArray_AS_STRING(translations.ptr())); }
+    Quaternion* rotationData() { return reinterpret_cast<Quaternion*>(PyByteArray_AS_STRING(rotations.ptr())); }
+    Vector3* scalingData() { return reinterpret_cast<Vector3*>(PyByteArray_AS_STRING(scalings.ptr())); }
+    Matrix4* worldMatrixData() { return reinterpret_cast<Matrix4*>(PyByteArray_AS_STRING(worldMatrices.ptr())); }
+
+    std::size_t size{};
+    py::object parents, translations, rotations, scalings, worldMatrices;
+};
+
+/* Adds new objects with identity transformation, returns index of the
+   first */
+std::size_t addObjects(FlatScene3D& self, Containers::ArrayView<const Int> parents) {
+    /* Check everything upfront to not end up with arrays of different sizes
+       if only some of them can't be resized */
+    for(py::object* array: {&self.parents, &self.translations, &self.rotations, &self.scalings, &self.worldMatrices}) {
+        if(reinterpret_cast<PyByteArrayObject*>(array->ptr())->ob_exports) {
+            PyErr_SetString(PyExc_BufferError, "can't add objects while views on the scene arrays exist");
+            throw py::error_already_set{};
+        }
+    }
+    const std::size_t first = self.size;
+    for(std::size_t i = 0; i != parents.size(); ++i) {
+        if(parents[i] < -1 || parents[i] >= Int(first + i)) {
+            PyErr_Format(PyExc_ValueError, "parent of object %zu expected to be -1 or less than %zu but got %i", first + i, first + i, parents[i]);
+            throw py::error_already_set{};
+        }
+    }
+
+    const std::size_t size = first + parents.size();
+    if(PyByteArray_Resize(self.parents.ptr(), size*sizeof(Int)) != 0 ||
+       PyByteArray_Resize(self.translations.ptr(), size*sizeof(Vector3)) != 0 ||
+       PyByteArray_Resize(self.rotations.ptr(), size*sizeof(Quaternion)) != 0 ||
+       PyByteArray_Resize(self.scalings.ptr(), size*sizeof(Vector3)) != 0 ||
+       PyByteArray_Resize(self.worldMatrices.ptr(), size*sizeof(Matrix4)) != 0)
+        throw py::error_already_set{};
+    self.size = size;
+
+    for(std::size_t i = first; i != size; ++i) {
+        self.parentData()[i] = parents[i - first];
+        self.translationData()[i] = {};
+        self.rotationData()[i] = {};
+        self.scalingData()[i] = Vector3{1.0f};
+        self.worldMatrixData()[i] = Matrix4{Math::IdentityInit};
+    }
+
+    return first;
+}
+
+/* Same as Quaternion::toMatrix(), but without the assertion for
+   normalization, as the data come directly from the user */
+Matrix3x3 rotationMatrix(const Quaternion& q) {
+    const Vector3& v = q.vector();
+    const Float s = q.scalar();
+    return Matrix3x3{
+        Vector3{1.0f - 2.0f*v.y()*v.y() - 2.0f*v.z()*v.z(),
+                2.0f*v.x()*v.y() + 2.0f*v.z()*s,
+                2.0f*v.x()*v.z() - 2.0f*v.y()*s},
+        Vector3{2.0f*v.x()*v.y() - 2.0f*v.z()*s,
+                1.0f - 2.0f*v.x()*v.x() - 2.0f*v.z()*v.z(),
+                2.0f*v.y()*v.z() + 2.0f*v.x()*s},
+        Vector3{2.0f*v.x()*v.z() + 2.0f*v.y()*s,
+                2.0f*v.y()*v.z() - 2.0f*v.x()*s,
+                1.0f - 2.0f*v.x()*v.x() - 2.0f*v.y()*v.y()}};
+}
+
+void update(FlatScene3D& self) {
+    const Int* parents = self.parentData();
+    const Vector3* translations = self.translationData();
+    const Quaternion* rotations = self.rotationData();
+    const Vector3* scalings = self.scalingData();
+
+    /* The parents array is writable from Python, so check it again. Done
+       upfront to not leave the world matrices half-updated on failure. */
+    for(std::size_t i = 0; i != self.size; ++i) {
+        if(parents[i] < -1 || parents[i] >= Int(i)) {
+            PyErr_Format(PyExc_ValueError, "parent of object %zu expected to be -1 or less than %zu but got %i", i, i, parents[i]);
+            throw py::error_already_set{};
+        }
+    }
+
+    /* Parents are always before children, so the parent matrix is always
+       already calculated */
+    Matrix4* worldMatrices = self.worldMatrixData();
+    for(std::size_t i = 0; i != self.size; ++i) {
+        Matrix3x3 rotationScaling = rotationMatrix(rotations[i]);
+        for(std::size_t j = 0; j != 3; ++j)
+            rotationScaling[j] *= scalings[i][j];
+        const Matrix4 world = Matrix4::from(rotationScaling, translations[i]);
+
+        worldMatrices[i] = parents[i] == -1 ? world :
+            worldMatrices[parents[i]]*world;
+    }
+}
+
+/* Reads a parent index of given integer type, checking it fits into 32
+   bits */
+template<class T> bool readParent(const char* item, Int& out, std::true_type) {
+    T value;
+    std::memcpy(&value, item, sizeof(T));
+    if(value < -2147483647ll - 1 || value > 2147483647ll) return false;
+    out = Int(value);
+    return true;
+}
+template<class T> bool readParent(const char* item, Int& out, std::false_type) {
+    T value;
+    std::memcpy(&value, item, sizeof(T));
+    if(value > 2147483647ull) return false;
+    out = Int(value);
+    return true;
+}
+template<class T> bool readParent(const char* item, Int& out) {
+    return readParent<T>(item, out, std::is_signed<T>{});
+}
+
+/* Parent indices from a one-dimensional buffer of any integer type, such as
+   a numpy array with the default 64-bit integers, narrowed to 32 bits. The
+   buffer is released in any case. */
+std::vector<Int> narrowParents(Py_buffer& buffer) {
+    bool(*read)(const char*, Int&) = nullptr;
+    /* Expecting just an one-letter format */
+    switch(buffer.format[1] ? '\0' : buffer.format[0]) {
+        case 'b': read = readParent<signed char>; break;
+        case 'B': read = readParent<unsigned char>; break;
+        case 'h': read = readParent<short>; break;
+        case 'H': read = readParent<unsigned short>; break;
+        case 'i': read = readParent<int>; break;
+        case 'I': read = readParent<unsigned int>; break;
+        case 'l': read = readParent<long>; break;
+        case 'L': read = readParent<unsigned long>; break;
+        case 'q': read = readParent<long long>; break;
+        case 'Q': read = readParent<unsigned long long>; break;
+    }
+
+    std::vector<Int> out;
+    if(buffer.ndim != 1)
+        PyErr_Format(PyExc_BufferError, "expected 1 dimensions but got %i", buffer.ndim);
+    else if(!read)
+        PyErr_Format(PyExc_BufferError, "expected an integer format but got %s", buffer.format);
+    else for(std::size_t i = 0; i != std::size_t(buffer.shape[0]); ++i) {
+        Int parent;
+        if(!read(static_cast<const char*>(buffer.buf) + i*buffer.strides[0], parent)) {
+            PyErr_Format(PyExc_ValueError, "parent %zu doesn't fit into a 32-bit integer", i);
+            break;
+        }
+        out.push_back(parent);
+    }
+
+    PyBuffer_Release(&buffer);
+    if(PyErr_Occurred()) throw py::error_already_set{};
+    return out;
+}
+
+}
+
+void scenegraphFlat(py::module& m) {
+    py::class_<FlatScene3D>{m, "FlatScene3D", "Three-dimensional scene stored as a structure of arrays"}
+        .def(py::init(), "Constructor")
+        .def("__len__", [](FlatScene3D& self) {
+            return self.size;
+        }, "Object count")
+        .def("add", [](FlatScene3D& self, Int parent) {
+            return addObjects(self, {&parent, 1});
+        }, "Add an object", py::arg("parent") = -1)
+        .def("extend", [](FlatScene3D& self, py::handle parents) {
+            /* Fast path for buffers, anything else goes through an
+               iteration */
+            if(PyObject_CheckBuffer(parents.ptr())) {
+                /* GCC 4.8 otherwise loudly complains about missing
+                   initializers */
+                Py_buffer buffer{nullptr, nullptr, 0, 0, 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr};
+                if(PyObject_GetBuffer(parents.ptr(), &buffer, PyBUF_FORMAT|PyBUF_STRIDES) != 0)
+                    throw py::error_already_set{};
+
+                /* 32-bit integers are used directly, other integer types
+                   get narrowed */
+                if(buffer.format[0] == 'i' && !buffer.format[1]) {
+                    ArrayInput<Math::Vector<1, Int>> input{buffer};
+                    return addObjects(self, Containers::arrayCast<const Int>(input.view()));
+                }
+
+                const std::vector<Int> list = narrowParents(buffer);
+                return addObjects(self, {list.data(), list.size()});
+            }
+
+            std::vector<Int> list;
+            for(py::handle parent: py::reinterpret_borrow<py::iterable>(parents))
+                list.push_back(py::cast<Int>(parent));
+            return addObjects(self, {list.data(), list.size()});
+        }, "Add objects with given parents", py::arg("parents"))
+        .def("update", update, "Calculate world matrices of all objects")
+        .def_property_readonly("parents", [](FlatScene3D& self) {
+            return arrayOutputView<Math::Vector<1, Int>>(self.parents);
+        }, "Parent indices, -1 for root objects")
+        .def_property_readonly("translations", [](FlatScene3D& self) {
+            return arrayOutputView<Vector3>(self.translations);
+        }, "Translations")
+        .def_property_readonly("rotations", [](FlatScene3D& self) {
+            return arrayOutputView<Vector4>(self.rotations);
+        }, "Rotation quaternions, in the XYZW order")
+        .def_property_readonly("scalings", [](FlatScene3D& self) {
+            return arrayOutputView<Vector3>(self.scalings);
+        }, "Scalings")
+        .def_property_readonly("world_matrices", [](FlatScene3D& self) {
+            return arrayOutputView<Matrix4>(self.worldMatrices);
+        }, "World transformation matrices calculated by update()");
+}
+
+}
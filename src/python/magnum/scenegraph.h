@@ -25,18 +25,145 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <functional>
+#include <unordered_set>
+#include <vector>
 #include <pybind11/pybind11.h>
+#include <Magnum/DimensionTraits.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/SceneGraph/Drawable.h>
 #include <Magnum/SceneGraph/Object.h>
 #include <Magnum/SceneGraph/Scene.h>
 
 #include "Magnum/SceneGraph/Python.h"
 
+#include "magnum/arrayinput.h"
 #include "magnum/bootstrap.h"
 
 namespace magnum {
 
+/* Common base for all drawables created from Python, be it the PyDrawable
+   trampoline or the native drawables. Holds the data Camera.draw() uses for
+   culling and sorting.
+
+   Drawable groups and drawables are accessible only from Python, where the
+   drawable constructor always creates the PyDrawable alias and the native
+   drawables derive from this class as well, so every drawable in a group
+   derives from it. That makes the unchecked static_cast from a Drawable to
+   this class safe in the bindings. A new drawable class has to derive from
+   it too. */
+template<UnsignedInt dimensions, class T> struct PyDrawableBase: SceneGraph::PyFeature<SceneGraph::Drawable<dimensions, T>> {
+    explicit PyDrawableBase(SceneGraph::AbstractObject<dimensions, T>& object, SceneGraph::DrawableGroup<dimensions, T>* drawables): SceneGraph::PyFeature<SceneGraph::Drawable<dimensions, T>>{object, drawables} {}
+
+    typename DimensionTraits<dimensions, T>::RangeType bounds;
+    bool hasBounds{};
+    Long sortKey{};
+};
+
+/* Converts a Python iterable of objects to a list of references, checking
+   that all of them belong to given scene */
+template<class Transformation> std::vector<std::reference_wrapper<SceneGraph::Object<Transformation>>> sceneObjects(SceneGraph::Scene<Transformation>& scene, py::iterable objects) {
+    std::vector<std::reference_wrapper<SceneGraph::Object<Transformation>>> out;
+    for(py::handle item: objects) {
+        auto& object = py::cast<SceneGraph::Object<Transformation>&>(item);
+        if(object.scene() != &scene) {
+            PyErr_Format(PyExc_ValueError, "object %zu is not a part of this scene", out.size());
+            throw py::error_already_set{};
+        }
+        out.push_back(object);
+    }
+    return out;
+}
+
+/* Converts a Python object to a parent pointer, accepting an object, a scene
+   or None */
+template<class Transformation> SceneGraph::Object<Transformation>* objectParent(py::handle parentobj) {
+    if(py::isinstance<SceneGraph::PyObject<SceneGraph::Object<Transformation>>>(parentobj))
+        return py::cast<SceneGraph::PyObject<SceneGraph::Object<Transformation>>*>(parentobj);
+    if(py::isinstance<SceneGraph::Scene<Transformation>>(parentobj))
+        return py::cast<SceneGraph::Scene<Transformation>*>(parentobj);
+    if(parentobj.is_none())
+        return nullptr;
+
+    PyErr_Format(PyExc_TypeError, "expected Scene, Object or None, got %A", parentobj.get_type().ptr());
+    throw py::error_already_set{};
+}
+
+/* Increase refcount if a parent gets added, decrease it if a parent is
+   removed. The decrease is done last as it may delete the object. */
+template<class Transformation> void setObjectParent(SceneGraph::Object<Transformation>& object, SceneGraph::Object<Transformation>* parent) {
+    const bool hadParent = object.parent();
+    if(!hadParent && parent) py::cast(&object).inc_ref();
+
+    object.setParent(parent);
+
+    if(hadParent && !parent) py::cast(&object).dec_ref();
+}
+
+/* Disconnects given objects and all their descendants from their parents,
+   releasing the references held by the parents. Done children first so each
+   object has no children anymore when it gets disconnected or deleted, which
+   avoids both a recursive setDirty() on the subtree and a recursive
+   destruction through PyObject::doErase(). */
+template<class Transformation> void destroyObjectSubtrees(std::vector<SceneGraph::Object<Transformation>*> objects) {
+    /* Breadth-first, so parents are always before their children */
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        for(SceneGraph::Object<Transformation>* child = objects[i]->children().first(); child; child = child->nextSibling())
+            objects.push_back(child);
+
+    for(auto it = objects.rbegin(); it != objects.rend(); ++it)
+        if((*it)->parent()) setObjectParent<Transformation>(**it, nullptr);
+}
+
 template<class Transformation> void scene(py::class_<SceneGraph::Scene<Transformation>>& c) {
-    c.def(py::init(), "Constructor");
+    typedef MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type> MatrixType;
+
+    c
+        .def(py::init(), "Constructor")
+        .def("absolute_transformation_matrices", [](SceneGraph::Scene<Transformation>& self, py::iterable objects) {
+            /* Object::transformationMatrices() shares the computation of
+               common parents instead of walking up from each object */
+            const std::vector<MatrixType> matrices = self.transformationMatrices(sceneObjects(self, objects));
+            return arrayOutput<MatrixType>({matrices.data(), matrices.size()});
+        }, "Absolute transformation matrices of given objects", py::arg("objects"))
+        .def("all_absolute_transformation_matrices", [](SceneGraph::Scene<Transformation>& self) {
+            /* Depth-first traversal with parent transformations computed
+               before children, so each object is visited just once */
+            std::vector<SceneGraph::Object<Transformation>*> objects;
+            std::vector<MatrixType> matrices;
+            std::vector<std::pair<SceneGraph::Object<Transformation>*, std::size_t>> stack;
+            for(SceneGraph::Object<Transformation>* child = self.children().first(); child; child = child->nextSibling())
+                stack.emplace_back(child, ~std::size_t{});
+            while(!stack.empty()) {
+                SceneGraph::Object<Transformation>* object = stack.back().first;
+                const std::size_t parent = stack.back().second;
+                stack.pop_back();
+
+                const std::size_t index = objects.size();
+                objects.push_back(object);
+                matrices.push_back(parent == ~std::size_t{} ?
+                    object->transformationMatrix() :
+                    matrices[parent]*object->transformationMatrix());
+                for(SceneGraph::Object<Transformation>* child = object->children().first(); child; child = child->nextSibling())
+                    stack.emplace_back(child, index);
+            }
+
+            py::list pyObjects;
+            for(SceneGraph::Object<Transformation>* object: objects)
+                pyObjects.append(py::cast(object));
+            return py::make_tuple(pyObjects, arrayOutput<MatrixType>({matrices.data(), matrices.size()}));
+        }, "All objects in the scene and their absolute transformation matrices")
+        .def("set_clean", [](SceneGraph::Scene<Transformation>& self, py::iterable objects) {
+            /* Shares the computation for common parents, same as
+               absolute_transformation_matrices() */
+            SceneGraph::Object<Transformation>::setClean(sceneObjects(self, objects));
+        }, "Clean absolute transformations of given objects", py::arg("objects"))
+        .def("clear", [](SceneGraph::Scene<Transformation>& self) {
+            std::vector<SceneGraph::Object<Transformation>*> children;
+            for(SceneGraph::Object<Transformation>* child = self.children().first(); child; child = child->nextSibling())
+                children.push_back(child);
+            destroyObjectSubtrees<Transformation>(std::move(children));
+        }, "Remove all objects from the scene");
 }
 
 template<UnsignedInt dimensions, class T, class Transformation> void object(py::class_<SceneGraph::Object<Transformation>, SceneGraph::PyObject<SceneGraph::Object<Transformation>>, SceneGraph::AbstractObject<dimensions, T>, SceneGraph::PyObjectHolder<SceneGraph::Object<Transformation>>>& c) {
@@ -53,25 +180,32 @@ template<UnsignedInt dimensions, class T, class Transformation> void object(py::
         .def_property("parent", [](SceneGraph::PyObject<SceneGraph::Object<Transformation>>& self) {
             return static_cast<SceneGraph::PyObject<SceneGraph::Object<Transformation>>*>(self.parent());
         }, [](SceneGraph::PyObject<SceneGraph::Object<Transformation>>& self, py::object parentobj) {
-            SceneGraph::Object<Transformation>* parent;
-            if(py::isinstance<SceneGraph::PyObject<SceneGraph::Object<Transformation>>>(parentobj))
-                parent = py::cast<SceneGraph::PyObject<SceneGraph::Object<Transformation>>*>(parentobj);
-            else if(py::isinstance<SceneGraph::Scene<Transformation>>(parentobj))
-                parent = py::cast<SceneGraph::Scene<Transformation>*>(parentobj);
-            else if(py::isinstance<py::none>(parentobj))
-                parent = nullptr;
-            else {
-                PyErr_Format(PyExc_TypeError, "expected Scene, Object or None, got %A", parentobj.get_type().ptr());
-                throw py::error_already_set{};
+            setObjectParent<Transformation>(self, objectParent<Transformation>(parentobj));
+        }, "Parent object or None if this is the root object")
+        .def_static("reparent", [](py::iterable objects, py::object parentobj) {
+            SceneGraph::Object<Transformation>* parent = objectParent<Transformation>(parentobj);
+            std::vector<py::object> list;
+            std::unordered_set<SceneGraph::Object<Transformation>*> set;
+            for(py::handle item: objects) {
+                set.insert(&py::cast<SceneGraph::Object<Transformation>&>(item));
+                list.push_back(py::reinterpret_borrow<py::object>(item));
             }
 
-            /* Decrease refcount if a parent is removed, increase it if a
-               parent gets added */
-            if(self.parent() && !parent) py::cast(&self).dec_ref();
-            else if(!self.parent() && parent) py::cast(&self).inc_ref();
+            /* Check that the new parent isn't any of the objects or their
+               descendants upfront, walking up from the parent just once */
+            for(SceneGraph::Object<Transformation>* p = parent; p; p = p->parent()) if(set.count(p)) {
+                PyErr_SetString(PyExc_ValueError, "can't make an object a child of itself or its descendant");
+                throw py::error_already_set{};
+            }
 
-            self.setParent(parent);
-        }, "Parent object or None if this is the root object")
+            /* The list keeps the objects alive even if a reference held by a
+               parent gets released */
+            for(py::handle item: list)
+                setObjectParent<Transformation>(py::cast<SceneGraph::Object<Transformation>&>(item), parent);
+        }, "Set a parent of multiple objects at once", py::arg("objects"), py::arg("parent"))
+        .def("destroy_subtree", [](SceneGraph::PyObject<SceneGraph::Object<Transformation>>& self) {
+            destroyObjectSubtrees<Transformation>({&self});
+        }, "Remove the object and all its descendants from the hierarchy")
 
         /* Transformation APIs common to all implementations */
         .def_property("transformation",
@@ -161,6 +295,10 @@ template<class Transformation> void objectReflect(py::class_<SceneGraph::Object<
 
 void scenegraphMatrix(py::module& m);
 void scenegraphTrs(py::module& m);
+void scenegraphFlat(py::module& m);
+void scenegraphBvh(py::module& m);
+void scenegraphDrawables(py::module& m);
+void scenegraphAnimation(py::module& m);
 
 }
 
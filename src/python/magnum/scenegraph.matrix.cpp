@@ -25,6 +25,8 @@
 
 #include <Magnum/SceneGraph/MatrixTransformation2D.h>
 #include <Magnum/SceneGraph/MatrixTransformation3D.h>
+/* For the double variants, which are not compiled into the library */
+#include <Magnum/SceneGraph/Object.hpp>
 
 #include "scenegraph.h"
 
@@ -53,6 +55,26 @@ void scenegraphMatrix(py::module& m) {
     object3D(object3D_);
     objectScale(object3D_);
     objectReflect(object3D_);
+
+    py::class_<SceneGraph::Scene<SceneGraph::BasicMatrixTransformation2D<Double>>> scene2Dd{matrix, "Scene2Dd", "Two-dimensional double scene with matrix-based transformation implementation"};
+    scene(scene2Dd);
+
+    py::class_<SceneGraph::Scene<SceneGraph::BasicMatrixTransformation3D<Double>>> scene3Dd{matrix, "Scene3Dd", "Three-dimensional double scene with matrix-based transformation implementation"};
+    scene(scene3Dd);
+
+    py::class_<SceneGraph::Object<SceneGraph::BasicMatrixTransformation2D<Double>>, SceneGraph::PyObject<SceneGraph::Object<SceneGraph::BasicMatrixTransformation2D<Double>>>, SceneGraph::AbstractObject<2, Double>, SceneGraph::PyObjectHolder<SceneGraph::Object<SceneGraph::BasicMatrixTransformation2D<Double>>>> object2Dd{matrix, "Object2Dd", "Two-dimensional double object with matrix-based transformation implementation"};
+    object(object2Dd);
+    objectTransform(object2Dd);
+    object2D(object2Dd);
+    objectScale(object2Dd);
+    objectReflect(object2Dd);
+
+    py::class_<SceneGraph::Object<SceneGraph::BasicMatrixTransformation3D<Double>>, SceneGraph::PyObject<SceneGraph::Object<SceneGraph::BasicMatrixTransformation3D<Double>>>, SceneGraph::AbstractObject<3, Double>, SceneGraph::PyObjectHolder<SceneGraph::Object<SceneGraph::BasicMatrixTransformation3D<Double>>>> object3Dd{matrix, "Object3Dd", "Three-dimensional double object with matrix-based transformation implementation"};
+    object(object3Dd);
+    objectTransform(object3Dd);
+    object3D(object3Dd);
+    objectScale(object3Dd);
+    objectReflect(object3Dd);
 }
 
 }
@@ -25,6 +25,8 @@
 
 #include <Magnum/SceneGraph/TranslationRotationScalingTransformation2D.h>
 #include <Magnum/SceneGraph/TranslationRotationScalingTransformation3D.h>
+/* For the double variants, which are not compiled into the library */
+#include <Magnum/SceneGraph/Object.hpp>
 
 #include "scenegraph.h"
 
@@ -32,6 +34,90 @@ namespace magnum {
 
 namespace {
 
+/* Rotations are passed through buffers as 4-component vectors for
+   quaternions (XYZW) and 2-component vectors for complex numbers */
+template<class T> Math::Vector4<T> rotationToVector(const Math::Quaternion<T>& rotation) {
+    return {rotation.vector(), rotation.scalar()};
+}
+template<class T> Math::Vector2<T> rotationToVector(const Math::Complex<T>& rotation) {
+    return {rotation.real(), rotation.imaginary()};
+}
+template<class T> void rotationFromVector(Math::Quaternion<T>& out, const Math::Vector4<T>& rotation) {
+    out = {rotation.xyz(), rotation.w()};
+}
+template<class T> void rotationFromVector(Math::Complex<T>& out, const Math::Vector2<T>& rotation) {
+    out = {rotation.x(), rotation.y()};
+}
+
+template<class Transformation> std::vector<SceneGraph::Object<Transformation>*> objectList(py::iterable objects) {
+    std::vector<SceneGraph::Object<Transformation>*> out;
+    for(py::handle item: objects)
+        out.push_back(&py::cast<SceneGraph::Object<Transformation>&>(item));
+    return out;
+}
+
+template<class T> void checkBatchSize(const ArrayInput<T>& input, std::size_t expected, const char* name) {
+    if(input.size() != expected) {
+        PyErr_Format(PyExc_ValueError, "expected %zu %s but got %zu", expected, name, input.size());
+        throw py::error_already_set{};
+    }
+}
+
+template<class Transformation> void objectTrsBatch(py::class_<SceneGraph::Object<Transformation>, SceneGraph::PyObject<SceneGraph::Object<Transformation>>, SceneGraph::AbstractObject<Transformation::Dimensions, typename Transformation::Type>, SceneGraph::PyObjectHolder<SceneGraph::Object<Transformation>>>& c) {
+    typedef SceneGraph::Object<Transformation> Object;
+    typedef VectorTypeFor<Transformation::Dimensions, typename Transformation::Type> VectorType;
+    typedef typename std::decay<decltype(std::declval<Object>().rotation())>::type RotationType;
+    typedef decltype(rotationToVector(std::declval<RotationType>())) RotationVectorType;
+
+    /* The setters mark each object as dirty, same as the properties */
+    c
+        .def_static("translations", [](py::iterable objects) {
+            const std::vector<Object*> list = objectList<Transformation>(objects);
+            std::vector<VectorType> out;
+            out.reserve(list.size());
+            for(Object* object: list) out.push_back(object->translation());
+            return arrayOutput<VectorType>({out.data(), out.size()});
+        }, "Translations of given objects", py::arg("objects"))
+        .def_static("set_translations", [](py::iterable objects, py::handle translations) {
+            const std::vector<Object*> list = objectList<Transformation>(objects);
+            ArrayInput<VectorType> input{translations};
+            checkBatchSize(input, list.size(), "translations");
+            for(std::size_t i = 0; i != list.size(); ++i)
+                list[i]->setTranslation(input[i]);
+        }, "Set translations of given objects", py::arg("objects"), py::arg("translations"))
+        .def_static("rotations", [](py::iterable objects) {
+            const std::vector<Object*> list = objectList<Transformation>(objects);
+            std::vector<RotationVectorType> out;
+            out.reserve(list.size());
+            for(Object* object: list) out.push_back(rotationToVector(object->rotation()));
+            return arrayOutput<RotationVectorType>({out.data(), out.size()});
+        }, "Rotations of given objects", py::arg("objects"))
+        .def_static("set_rotations", [](py::iterable objects, py::handle rotations) {
+            const std::vector<Object*> list = objectList<Transformation>(objects);
+            ArrayInput<RotationVectorType> input{rotations};
+            checkBatchSize(input, list.size(), "rotations");
+            RotationType rotation;
+            for(std::size_t i = 0; i != list.size(); ++i) {
+                rotationFromVector(rotation, input[i]);
+                list[i]->setRotation(rotation);
+            }
+        }, "Set rotations of given objects", py::arg("objects"), py::arg("rotations"))
+        .def_static("scalings", [](py::iterable objects) {
+            const std::vector<Object*> list = objectList<Transformation>(objects);
+            std::vector<VectorType> out;
+            out.reserve(list.size());
+            for(Object* object: list) out.push_back(object->scaling());
+            return arrayOutput<VectorType>({out.data(), out.size()});
+        }, "Scalings of given objects", py::arg("objects"))
+        .def_static("set_scalings", [](py::iterable objects, py::handle scalings) {
+            const std::vector<Object*> list = objectList<Transformation>(objects);
+            ArrayInput<VectorType> input{scalings};
+            checkBatchSize(input, list.size(), "scalings");
+            for(std::size_t i = 0; i != list.size(); ++i)
+                list[i]->setScaling(input[i]);
+        }, "Set scalings of given objects", py::arg("objects"), py::arg("scalings"));
+}
+
 template<class Transformation> void objectTrs(py::class_<SceneGraph::Object<Transformation>, SceneGraph::PyObject<SceneGraph::Object<Transformation>>, SceneGraph::AbstractObject<Transformation::Dimensions, typename Transformation::Type>, SceneGraph::PyObjectHolder<SceneGraph::Object<Transformation>>>& c) {
     c
         .def_property("translation",
@@ -65,12 +151,34 @@ void scenegraphTrs(py::module& m) {
     object2D(object2D_);
     objectScale(object2D_);
     objectTrs(object2D_);
+    objectTrsBatch(object2D_);
 
     py::class_<SceneGraph::Object<SceneGraph::TranslationRotationScalingTransformation3D>, SceneGraph::PyObject<SceneGraph::Object<SceneGraph::TranslationRotationScalingTransformation3D>>, SceneGraph::AbstractObject3D, SceneGraph::PyObjectHolder<SceneGraph::Object<SceneGraph::TranslationRotationScalingTransformation3D>>> object3D_{matrix, "Object3D", "Three-dimensional object with TRS-based transformation implementation"};
     object(object3D_);
     object3D(object3D_);
     objectScale(object3D_);
     objectTrs(object3D_);
+    objectTrsBatch(object3D_);
+
+    py::class_<SceneGraph::Scene<SceneGraph::BasicTranslationRotationScalingTransformation2D<Double>>> scene2Dd{matrix, "Scene2Dd", "Two-dimensional double scene with TRS-based transformation implementation"};
+    scene(scene2Dd);
+
+    py::class_<SceneGraph::Scene<SceneGraph::BasicTranslationRotationScalingTransformation3D<Double>>> scene3Dd{matrix, "Scene3Dd", "Three-dimensional double scene with TRS-based transformation implementation"};
+    scene(scene3Dd);
+
+    py::class_<SceneGraph::Object<SceneGraph::BasicTranslationRotationScalingTransformation2D<Double>>, SceneGraph::PyObject<SceneGraph::Object<SceneGraph::BasicTranslationRotationScalingTransformation2D<Double>>>, SceneGraph::AbstractObject<2, Double>, SceneGraph::PyObjectHolder<SceneGraph::Object<SceneGraph::BasicTranslationRotationScalingTransformation2D<Double>>>> object2Dd{matrix, "Object2Dd", "Two-dimensional double object with TRS-based transformation implementation"};
+    object(object2Dd);
+    object2D(object2Dd);
+    objectScale(object2Dd);
+    objectTrs(object2Dd);
+    objectTrsBatch(object2Dd);
+
+    py::class_<SceneGraph::Object<SceneGraph::BasicTranslationRotationScalingTransformation3D<Double>>, SceneGraph::PyObject<SceneGraph::Object<SceneGraph::BasicTranslationRotationScalingTransformation3D<Double>>>, SceneGraph::AbstractObject<3, Double>, SceneGraph::PyObjectHolder<SceneGraph::Object<SceneGraph::BasicTranslationRotationScalingTransformation3D<Double>>>> object3Dd{matrix, "Object3Dd", "Three-dimensional double object with TRS-based transformation implementation"};
+    object(object3Dd);
+    object3D(object3Dd);
+    objectScale(object3Dd);
+    objectTrs(object3Dd);
+    objectTrsBatch(object3Dd);
 }
 
 }
@@ -26,6 +26,8 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h> /* for vector arguments */
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/DimensionTraits.h>
 #include <Magnum/GL/Mesh.h>
 #include <Magnum/GL/Texture.h>
 #include <Magnum/Math/Color.h>
@@ -36,16 +38,21 @@
 #include <Magnum/Shaders/VertexColor.h>
 
 #include "Corrade/Python.h"
+#include "Magnum/GL/Python.h"
 
 #include "corrade/EnumOperators.h"
+#include "magnum/arrayinput.h"
 #include "magnum/bootstrap.h"
 
 namespace magnum {
 
 namespace {
 
-template<class T> void anyShader(PyNonDestructibleClass<T, GL::AbstractShaderProgram>& c) {
-    c.def("draw", static_cast<void(GL::AbstractShaderProgram::*)(GL::Mesh&)>(&GL::AbstractShaderProgram::draw), "Draw a mesh");
+template<class T> void checkBatchSize(const ArrayInput<T>& input, const std::size_t expected, const char* const name) {
+    if(input.size() != expected) {
+        PyErr_Format(PyExc_ValueError, "expected %zu %s but got %zu", expected, name, input.size());
+        throw py::error_already_set{};
+    }
 }
 
 template<UnsignedInt dimensions> void flat(PyNonDestructibleClass<Shaders::Flat<dimensions>, GL::AbstractShaderProgram>& c) {
@@ -81,9 +88,27 @@ template<UnsignedInt dimensions> void flat(PyNonDestructibleClass<Shaders::Flat<
             }
 
             self.bindTexture(texture);
-        }, "Bind a color texture");
+        }, "Bind a color texture")
+        .def("draw_batch", [](Shaders::Flat<dimensions>& self, GL::Mesh& mesh, py::handle transformationProjectionMatrices, py::handle colors) {
+            ArrayInput<MatrixTypeFor<dimensions, Float>> matrices{transformationProjectionMatrices};
+            if(colors.is_none()) {
+                GL::pyHooks().draw(self, matrices.size());
+                for(std::size_t i = 0; i != matrices.size(); ++i)
+                    self.setTransformationProjectionMatrix(matrices[i])
+                        .draw(mesh);
+                return;
+            }
 
-    anyShader(c);
+            ArrayInput<Color4> colorInput{colors};
+            checkBatchSize(colorInput, matrices.size(), "colors");
+            GL::pyHooks().draw(self, matrices.size());
+            for(std::size_t i = 0; i != matrices.size(); ++i)
+                self.setTransformationProjectionMatrix(matrices[i])
+                    .setColor(colorInput[i])
+                    .draw(mesh);
+        }, "Draw a mesh multiple times with different per-draw uniforms",
+            py::arg("mesh"), py::arg("transformation_projection_matrices"),
+            py::arg("colors") = py::none{});
 }
 
 template<UnsignedInt dimensions> void vertexColor(PyNonDestructibleClass<Shaders::VertexColor<dimensions>, GL::AbstractShaderProgram>& c) {
@@ -98,9 +123,15 @@ template<UnsignedInt dimensions> void vertexColor(PyNonDestructibleClass<Shaders
         /* Using lambdas to avoid method chaining getting into signatures */
 
         .def_property("transformation_projection_matrix", nullptr, &Shaders::VertexColor<dimensions>::setTransformationProjectionMatrix,
-            "Transformation and projection matrix");
-
-    anyShader(c);
+            "Transformation and projection matrix")
+        .def("draw_batch", [](Shaders::VertexColor<dimensions>& self, GL::Mesh& mesh, py::handle transformationProjectionMatrices) {
+            ArrayInput<MatrixTypeFor<dimensions, Float>> matrices{transformationProjectionMatrices};
+            GL::pyHooks().draw(self, matrices.size());
+            for(std::size_t i = 0; i != matrices.size(); ++i)
+                self.setTransformationProjectionMatrix(matrices[i])
+                    .draw(mesh);
+        }, "Draw a mesh multiple times with different per-draw uniforms",
+            py::arg("mesh"), py::arg("transformation_projection_matrices"));
 }
 
 }
@@ -211,22 +242,68 @@ void shaders(py::module& m) {
                 &Shaders::Phong::setNormalMatrix, "Set normal matrix")
             .def_property("projection_matrix", nullptr,
                 &Shaders::Phong::setProjectionMatrix, "Set projection matrix")
-            .def_property("light_positions", nullptr, [](Shaders::Phong& self, const std::vector<Vector3>& positions) {
-                if(positions.size() != self.lightCount()) {
-                    PyErr_Format(PyExc_ValueError, "expected %u items but got %u", self.lightCount(), UnsignedInt(positions.size()));
+            .def_property("light_positions", nullptr, [](Shaders::Phong& self, py::handle positions) {
+                /* Fast path for numpy arrays and other buffers, avoiding a
+                   copy to a std::vector if the layout matches */
+                if(PyObject_CheckBuffer(positions.ptr())) {
+                    ArrayInput<Vector3> input{positions};
+                    checkBatchSize(input, self.lightCount(), "items");
+                    self.setLightPositions(input.view());
+                    return;
+                }
+
+                const auto vector = py::cast<std::vector<Vector3>>(positions);
+                if(vector.size() != self.lightCount()) {
+                    PyErr_Format(PyExc_ValueError, "expected %u items but got %u", self.lightCount(), UnsignedInt(vector.size()));
                     throw py::error_already_set{};
                 }
 
-                self.setLightPositions(positions);
+                self.setLightPositions(vector);
             }, "Light positions")
-            .def_property("light_colors", nullptr, [](Shaders::Phong& self, const std::vector<Color4>& colors) {
-                if(colors.size() != self.lightCount()) {
-                    PyErr_Format(PyExc_ValueError, "expected %u items but got %u", self.lightCount(), UnsignedInt(colors.size()));
+            .def_property("light_colors", nullptr, [](Shaders::Phong& self, py::handle colors) {
+                if(PyObject_CheckBuffer(colors.ptr())) {
+                    ArrayInput<Color4> input{colors};
+                    checkBatchSize(input, self.lightCount(), "items");
+                    self.setLightColors(input.view());
+                    return;
+                }
+
+                const auto vector = py::cast<std::vector<Color4>>(colors);
+                if(vector.size() != self.lightCount()) {
+                    PyErr_Format(PyExc_ValueError, "expected %u items but got %u", self.lightCount(), UnsignedInt(vector.size()));
                     throw py::error_already_set{};
                 }
 
-                self.setLightColors(colors);
+                self.setLightColors(vector);
             }, "Light colors")
+            .def("draw_batch", [](Shaders::Phong& self, GL::Mesh& mesh, py::handle transformationMatrices, py::handle normalMatrices, py::handle diffuseColors) {
+                ArrayInput<Matrix4> transformations{transformationMatrices};
+
+                /* Normal matrices are calculated from the transformation if
+                   not supplied */
+                Containers::Pointer<ArrayInput<Matrix3x3>> normals;
+                if(!normalMatrices.is_none()) {
+                    normals.reset(new ArrayInput<Matrix3x3>{normalMatrices});
+                    checkBatchSize(*normals, transformations.size(), "normal matrices");
+                }
+                Containers::Pointer<ArrayInput<Color4>> colors;
+                if(!diffuseColors.is_none()) {
+                    colors.reset(new ArrayInput<Color4>{diffuseColors});
+                    checkBatchSize(*colors, transformations.size(), "colors");
+                }
+
+                GL::pyHooks().draw(self, transformations.size());
+                for(std::size_t i = 0; i != transformations.size(); ++i) {
+                    self.setTransformationMatrix(transformations[i])
+                        .setNormalMatrix(normals ? (*normals)[i] :
+                            transformations[i].normalMatrix());
+                    if(colors) self.setDiffuseColor((*colors)[i]);
+                    self.draw(mesh);
+                }
+            }, "Draw a mesh multiple times with different per-draw uniforms",
+                py::arg("mesh"), py::arg("transformation_matrices"),
+                py::arg("normal_matrices") = py::none{},
+                py::arg("diffuse_colors") = py::none{})
 
             .def("bind_ambient_texture", [](Shaders::Phong& self, GL::Texture2D& texture) {
                 if(!(self.flags() & Shaders::Phong::Flag::AmbientTexture)) {
@@ -269,8 +346,6 @@ void shaders(py::module& m) {
                 self.bindTextures(ambient, diffuse, specular, normal);
             }, "Bind textures", py::arg("ambient") = nullptr, py::arg("diffuse") = nullptr, py::arg("specular") = nullptr, py::arg("normal") = nullptr)
             ;
-
-        anyShader(phong);
     }
 }
 
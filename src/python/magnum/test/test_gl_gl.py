@@ -24,13 +24,16 @@
 #
 
 import array
+import os
 import sys
+import tempfile
 import unittest
 
 # setUpModule gets called before everything else, skipping if GL tests can't
 # be run
 from . import GLTestCase, setUpModule
 
+from corrade import containers
 import magnum
 from magnum import *
 from magnum import gl
@@ -96,6 +99,58 @@ void main() {
         self.assertGreaterEqual(location, 0)
         a.set_uniform(location, Matrix4())
 
+        # Array upload, converted from doubles
+        a.set_uniform_array(location, memoryview(array.array('d', [0.0]*16)).cast('B').cast('d', [1, 4, 4]))
+
+        # Pre-resolved setter, keeps a reference to the program
+        a_refcount = sys.getrefcount(a)
+        setter = a.uniform_setter(location, Matrix4)
+        self.assertEqual(setter.location, location)
+        self.assertEqual(sys.getrefcount(a), a_refcount + 1)
+        setter(Matrix4.translation(Vector3.x_axis()))
+
+        del setter
+        self.assertEqual(sys.getrefcount(a), a_refcount)
+
+    def test_uniform_array_invalid(self):
+        a = gl.AbstractShaderProgram()
+        with self.assertRaisesRegex(BufferError, r"unsupported uniform array of format f and shape \(1, 5\)"):
+            a.set_uniform_array(0, memoryview(array.array('f', [0.0]*5)).cast('B').cast('f', [1, 5]))
+        with self.assertRaisesRegex(BufferError, r"unsupported uniform array of format b and shape \(3\)"):
+            a.set_uniform_array(0, array.array('b', [0]*3))
+
+    def test_uniform_setter_invalid(self):
+        a = gl.AbstractShaderProgram()
+        with self.assertRaisesRegex(TypeError, "unsupported uniform type <class 'str'>"):
+            a.uniform_setter(0, str)
+
+    def test_link_async(self):
+        a = gl.AbstractShaderProgram()
+        b = gl.AbstractShaderProgram()
+
+        # Link of an empty shader will always fail, but it's reported only
+        # once checked
+        gl.AbstractShaderProgram.link_all([a, b])
+        while not a.link_finished: pass
+        with self.assertRaisesRegex(RuntimeError, "linking failed"):
+            a.check_link()
+
+        # A draw checks the pending link first
+        with self.assertRaisesRegex(RuntimeError, "linking failed"):
+            b.draw(gl.Mesh())
+
+        # Checked already, so it's not pending anymore
+        self.assertTrue(b.link_finished)
+
+    def test_release_gil_on_draw(self):
+        self.assertFalse(gl.AbstractShaderProgram.release_gil_on_draw)
+
+        gl.AbstractShaderProgram.release_gil_on_draw = True
+        try:
+            self.assertTrue(gl.AbstractShaderProgram.release_gil_on_draw)
+        finally:
+            gl.AbstractShaderProgram.release_gil_on_draw = False
+
     def test_link_fail(self):
         a = gl.AbstractShaderProgram()
         # Link of an empty shader will always fail
@@ -114,6 +169,81 @@ void main() {
             with self.assertRaisesRegex(ValueError, "index of uniform block 'nonexistent' cannot be retrieved"):
                 a.uniform_block_index("nonexistent")
 
+@unittest.skipIf(magnum.TARGET_GLES2 or magnum.TARGET_WEBGL, "program binaries are not available on ES2 or WebGL")
+class ProgramBinaryCache(GLTestCase):
+    def program(self):
+        a = gl.AbstractShaderProgram()
+        version = gl.Version.GLES300 if magnum.TARGET_GLES else gl.Version.GL300
+
+        vert = gl.Shader(version, gl.Shader.Type.VERTEX)
+        vert.add_source("""
+in lowp vec4 position;
+
+void main() {
+    gl_Position = position;
+}
+        """.strip())
+        vert.compile()
+        a.attach_shader(vert)
+
+        frag = gl.Shader(version, gl.Shader.Type.FRAGMENT)
+        frag.add_source("""
+out lowp vec4 color;
+
+void main() {
+    color = vec4(0.0);
+}
+        """.strip())
+        frag.compile()
+        a.attach_shader(frag)
+
+        a.bind_attribute_location(0, "position")
+        a.retrievable_binary = True
+        a.link()
+        return a
+
+    def test(self):
+        if not gl.ProgramBinaryCache.supported:
+            self.skipTest("the driver doesn't support program binaries")
+
+        with tempfile.TemporaryDirectory() as directory:
+            cache = gl.ProgramBinaryCache(os.path.join(directory, 'cache'))
+
+            # Nothing cached yet
+            self.assertFalse(cache.load(gl.AbstractShaderProgram(), 'flat'))
+
+            cache.save(self.program(), 'flat')
+
+            a = gl.AbstractShaderProgram()
+            self.assertTrue(cache.load(a, 'flat'))
+            self.assertFalse(cache.load(gl.AbstractShaderProgram(), 'phong'))
+
+    def test_key_mismatch(self):
+        if not gl.ProgramBinaryCache.supported:
+            self.skipTest("the driver doesn't support program binaries")
+
+        with tempfile.TemporaryDirectory() as directory:
+            cache = gl.ProgramBinaryCache(directory)
+            cache.save(self.program(), 'flat')
+            flat, = os.listdir(directory)
+            cache.save(self.program(), 'phong')
+            phong, = set(os.listdir(directory)) - {flat}
+
+            # Pretend the hashes collided, the key stored in the file doesn't
+            # match so it's a cache miss
+            with open(os.path.join(directory, flat), 'rb') as f:
+                data = f.read()
+            with open(os.path.join(directory, phong), 'wb') as f:
+                f.write(data)
+            self.assertTrue(cache.load(gl.AbstractShaderProgram(), 'flat'))
+            self.assertFalse(cache.load(gl.AbstractShaderProgram(), 'phong'))
+
+    def test_save_not_linked(self):
+        with tempfile.TemporaryDirectory() as directory:
+            cache = gl.ProgramBinaryCache(directory)
+            with self.assertRaisesRegex(RuntimeError, "the program binary can't be retrieved"):
+                cache.save(gl.AbstractShaderProgram(), 'flat')
+
 class Buffer(GLTestCase):
     def test_init(self):
         a = gl.Buffer()
@@ -132,6 +262,107 @@ class Buffer(GLTestCase):
         a = gl.Buffer()
         a.set_data(array.array('f', [0.5, 1.2]))
 
+    @unittest.skipIf(magnum.TARGET_WEBGL, "buffer mapping is not available on WebGL")
+    def test_map(self):
+        a = gl.Buffer()
+        a.set_data(b'hello', gl.BufferUsage.DYNAMIC_DRAW)
+        a_refcount = sys.getrefcount(a)
+
+        view = a.map(1, 3, gl.Buffer.MapFlag.READ|gl.Buffer.MapFlag.WRITE)
+        self.assertIs(view.owner, a)
+        self.assertEqual(sys.getrefcount(a), a_refcount + 1)
+        self.assertEqual(bytes(view), b'ell')
+        view[0] = 'a'
+
+        del view
+        self.assertEqual(sys.getrefcount(a), a_refcount)
+        a.unmap()
+
+        view = a.map(0, 5, gl.Buffer.MapFlag.READ)
+        self.assertIsInstance(view, containers.ArrayView)
+        self.assertEqual(bytes(view), b'hallo')
+        del view
+        a.unmap()
+
+    @unittest.skipIf(magnum.TARGET_GLES2, "indexed buffer targets are not available on ES2")
+    def test_bind(self):
+        a = gl.Buffer()
+        a.set_data(b'\x00'*64)
+
+        gl.Renderer.statistics_enabled = True
+        gl.Renderer.reset_statistics()
+        a.bind(gl.Buffer.Target.UNIFORM, 0)
+        a.bind(gl.Buffer.Target.UNIFORM, 1, 0, 16)
+        self.assertEqual(gl.Renderer.statistics['buffer_binds'], 2)
+        gl.Renderer.statistics_enabled = False
+
+        gl.Buffer.unbind(gl.Buffer.Target.UNIFORM, 0)
+        gl.Buffer.unbind(gl.Buffer.Target.UNIFORM, 1)
+
+@unittest.skipIf(magnum.TARGET_GLES2, "buffer images are not available on ES2")
+class BufferImage(GLTestCase):
+    def test_init(self):
+        a = gl.BufferImage2D(PixelFormat.RGBA8_UNORM)
+        self.assertEqual(a.size, Vector2i())
+        self.assertEqual(a.pixel_size, 4)
+        self.assertEqual(a.data_size, 0)
+
+        b = gl.BufferImage2D(PixelStorage(), PixelFormat.R8_UNORM)
+        self.assertEqual(b.pixel_size, 1)
+        self.assertEqual(b.buffer.target_hint, gl.Buffer.TargetHint.PIXEL_PACK)
+
+@unittest.skipIf(magnum.TARGET_GLES2 or magnum.TARGET_WEBGL, "compute shaders are not available on ES2 or WebGL")
+class Compute(GLTestCase):
+    def setUp(self):
+        super().setUp()
+        self.version = gl.Version.GLES310 if magnum.TARGET_GLES else gl.Version.GL430
+        if not gl.is_version_supported(self.version):
+            self.skipTest("compute shaders are not supported")
+
+    def test_shader_storage(self):
+        compute = gl.Shader(self.version, gl.Shader.Type.COMPUTE)
+        compute.add_source("""
+layout(local_size_x = 4) in;
+
+layout(std430, binding = 0) buffer Data {
+    highp float data[];
+};
+
+void main() {
+    data[gl_GlobalInvocationID.x] *= 2.0;
+}
+        """.strip())
+        compute.compile()
+
+        program = gl.AbstractShaderProgram()
+        program.attach_shader(compute)
+        program.link()
+
+        buffer = gl.Buffer()
+        buffer.set_data(array.array('f', [1.0, 2.0, 3.0, 4.0]).tobytes())
+        buffer.bind(gl.Buffer.Target.SHADER_STORAGE, 0)
+        program.dispatch_compute((1, 1, 1))
+        gl.Renderer.set_memory_barrier(gl.Renderer.MemoryBarrier.BUFFER_UPDATE)
+        gl.Buffer.unbind(gl.Buffer.Target.SHADER_STORAGE, 0)
+
+        view = buffer.map(0, 16, gl.Buffer.MapFlag.READ)
+        self.assertEqual(list(array.array('f', bytes(view))), [2.0, 4.0, 6.0, 8.0])
+        del view
+        buffer.unmap()
+
+    def test_image(self):
+        texture = gl.Texture2D()
+        texture.set_storage(1, gl.TextureFormat.RGBA8, Vector2i(4))
+        texture.bind_image(0, 0, gl.ImageAccess.WRITE_ONLY, gl.ImageFormat.RGBA8)
+        gl.Renderer.set_memory_barrier(gl.Renderer.MemoryBarrier.SHADER_IMAGE_ACCESS|gl.Renderer.MemoryBarrier.TEXTURE_FETCH)
+        gl.AbstractTexture.unbind_image(0)
+
+        array_texture = gl.Texture2DArray()
+        array_texture.set_storage(1, gl.TextureFormat.R32F, Vector3i(4, 4, 2))
+        array_texture.bind_image(0, 0, 1, gl.ImageAccess.READ_ONLY, gl.ImageFormat.R32F)
+        array_texture.bind_image_layered(0, 0, gl.ImageAccess.READ_WRITE, gl.ImageFormat.R32F)
+        gl.AbstractTexture.unbind_image(0)
+
 class DefaultFramebuffer(GLTestCase):
     def test(self):
         # Using it should not crash, leak or cause double-free issues
@@ -223,6 +454,119 @@ class Framebuffer(GLTestCase):
         self.assertEqual(ord(a.pixels[0, 1, 1]), 0x80)
         self.assertEqual(ord(a.pixels[1, 0, 2]), 0xbf)
 
+    @unittest.skipIf(magnum.TARGET_GLES2 or magnum.TARGET_WEBGL, "async readback is not available on ES2 or WebGL")
+    def test_read_async(self):
+        renderbuffer = gl.Renderbuffer()
+        renderbuffer.set_storage(gl.RenderbufferFormat.RGBA8, (4, 4))
+
+        framebuffer = gl.Framebuffer(((0, 0), (4, 4)))
+        framebuffer.attach_renderbuffer(gl.Framebuffer.ColorAttachment(0), renderbuffer)
+
+        gl.Renderer.clear_color = Color4(1.0, 0.5, 0.75)
+        framebuffer.clear(gl.FramebufferClear.COLOR)
+
+        a = gl.BufferImage2D(PixelFormat.RGBA8_UNORM)
+        readback = framebuffer.read_async(Range2Di.from_size((1, 1), (2, 2)), a)
+        self.assertIs(readback.image, a)
+        self.assertEqual(a.size, Vector2i(2, 2))
+        self.assertEqual(a.data_size, 16)
+
+        self.assertTrue(readback.wait())
+        self.assertTrue(readback.is_ready)
+
+        readback_refcount = sys.getrefcount(readback)
+
+        view = readback.map()
+        self.assertIs(view.owner, readback)
+        self.assertEqual(sys.getrefcount(readback), readback_refcount + 1)
+        self.assertEqual(view.size, Vector2i(2, 2))
+        self.assertEqual(view.format, PixelFormat.RGBA8_UNORM)
+        self.assertEqual(ord(view.pixels[0, 0, 0]), 0xff)
+        self.assertEqual(ord(view.pixels[0, 1, 1]), 0x80)
+        self.assertEqual(ord(view.pixels[1, 0, 2]), 0xbf)
+
+        with self.assertRaisesRegex(RuntimeError, "the buffer is already mapped"):
+            readback.map()
+
+        del view
+        self.assertEqual(sys.getrefcount(readback), readback_refcount)
+        readback.unmap()
+
+        with self.assertRaisesRegex(RuntimeError, "the buffer is not mapped"):
+            readback.unmap()
+
+    def test_attach_texture(self):
+        texture = gl.Texture2D()
+        texture.set_storage(1, gl.TextureFormat.RGBA8, (4, 4))
+        texture_refcount = sys.getrefcount(texture)
+
+        framebuffer = gl.Framebuffer(((0, 0), (4, 4)))
+        framebuffer.attach_texture(gl.Framebuffer.ColorAttachment(0), texture, 0)
+        self.assertEqual(len(framebuffer.attachments), 1)
+        self.assertIs(framebuffer.attachments[0], texture)
+        self.assertEqual(sys.getrefcount(texture), texture_refcount + 1)
+
+        cube_map = gl.CubeMapTexture()
+        cube_map.set_storage(1, gl.TextureFormat.RGBA8, (4, 4))
+        framebuffer.attach_cube_map_texture(gl.Framebuffer.ColorAttachment(0), cube_map, gl.CubeMapCoordinate.POSITIVE_X, 0)
+        self.assertIs(framebuffer.attachments[1], cube_map)
+
+        if not magnum.TARGET_GLES2:
+            texture_array = gl.Texture2DArray()
+            texture_array.set_storage(1, gl.TextureFormat.RGBA8, (4, 4, 2))
+            framebuffer.attach_texture_layer(gl.Framebuffer.ColorAttachment(0), texture_array, 0, 1)
+            self.assertIs(framebuffer.attachments[2], texture_array)
+
+        del framebuffer
+        self.assertEqual(sys.getrefcount(texture), texture_refcount)
+
+    @unittest.skipIf(magnum.TARGET_GLES2 or magnum.TARGET_WEBGL, "multisample textures are not available on ES2 or WebGL")
+    def test_attach_multisample_texture(self):
+        if not gl.is_version_supported(gl.Version.GLES310 if magnum.TARGET_GLES else gl.Version.GL320):
+            self.skipTest("multisample textures are not supported")
+
+        texture = gl.MultisampleTexture2D()
+        texture.set_storage(4, gl.TextureFormat.RGBA8, (4, 4))
+        self.assertEqual(texture.image_size(), Vector2i(4, 4))
+
+        framebuffer = gl.Framebuffer(((0, 0), (4, 4)))
+        framebuffer.attach_texture(gl.Framebuffer.ColorAttachment(0), texture)
+        self.assertIs(framebuffer.attachments[0], texture)
+
+    @unittest.skipIf(magnum.TARGET_GLES2, "multisample renderbuffers are not available on ES2")
+    def test_resolve_and_read(self):
+        renderbuffer = gl.Renderbuffer()
+        renderbuffer.set_storage_multisample(4, gl.RenderbufferFormat.RGBA8, (4, 4))
+
+        framebuffer = gl.Framebuffer(((0, 0), (4, 4)))
+        framebuffer.attach_renderbuffer(gl.Framebuffer.ColorAttachment(0), renderbuffer)
+
+        gl.Renderer.clear_color = Color4(1.0, 0.5, 0.75)
+        framebuffer.clear(gl.FramebufferClear.COLOR)
+
+        a = Image2D(PixelFormat.RGBA8_UNORM)
+        framebuffer.resolve_and_read(Range2Di.from_size((1, 1), (2, 2)), a)
+        self.assertEqual(a.size, Vector2i(2, 2))
+        self.assertEqual(ord(a.pixels[0, 0, 0]), 0xff)
+        self.assertEqual(ord(a.pixels[0, 1, 1]), 0x80)
+
+        # The intermediate framebuffer is reused for the same size and
+        # recreated for a different one
+        framebuffer.resolve_and_read(Range2Di.from_size((1, 1), (2, 2)), a)
+        framebuffer.resolve_and_read(Range2Di.from_size((0, 0), (4, 4)), a)
+        self.assertEqual(a.size, Vector2i(4, 4))
+        self.assertEqual(ord(a.pixels[3, 3, 2]), 0xbf)
+
+        if not magnum.TARGET_WEBGL:
+            b = gl.BufferImage2D(PixelFormat.RGBA8_UNORM)
+            readback = framebuffer.resolve_and_read_async(Range2Di.from_size((1, 1), (2, 2)), b)
+            self.assertIs(readback.image, b)
+            self.assertTrue(readback.wait())
+            view = readback.map()
+            self.assertEqual(ord(view.pixels[1, 1, 0]), 0xff)
+            del view
+            readback.unmap()
+
 class Mesh(GLTestCase):
     def test_init(self):
         a = gl.Mesh()
@@ -270,6 +614,55 @@ class Mesh(GLTestCase):
         del mesh
         self.assertEqual(sys.getrefcount(buffer), buffer_refcount)
 
+class Query(GLTestCase):
+    @unittest.skipIf(magnum.TARGET_WEBGL and magnum.TARGET_GLES2, "sample queries are not available on WebGL 1")
+    def test_sample(self):
+        a = gl.SampleQuery(gl.SampleQuery.Target.ANY_SAMPLES_PASSED)
+        a.begin()
+        a.end()
+        self.assertEqual(a.result, 0)
+        self.assertTrue(a.result_available)
+
+    @unittest.skipIf(magnum.TARGET_GLES2, "primitive queries are not available on ES2")
+    def test_primitive(self):
+        a = gl.PrimitiveQuery(gl.PrimitiveQuery.Target.TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN)
+        a.begin()
+        a.end()
+        self.assertEqual(a.result, 0)
+
+    # TODO: re-enable on ES when extensions can be checked
+    @unittest.skipIf(magnum.TARGET_GLES, "time queries require an extension on ES which we can't check")
+    def test_time(self):
+        a = gl.TimeQuery(gl.TimeQuery.Target.TIME_ELAPSED)
+        a.begin()
+        gl.default_framebuffer.clear(gl.FramebufferClear.COLOR)
+        a.end()
+        self.assertGreaterEqual(a.result, 0)
+
+    # TODO: re-enable on ES when extensions can be checked
+    @unittest.skipIf(magnum.TARGET_GLES, "time queries require an extension on ES which we can't check")
+    def test_frame_timer(self):
+        a = gl.FrameTimer(delay=2)
+        self.assertIsNone(a.duration)
+
+        for i in range(3):
+            with a:
+                gl.default_framebuffer.clear(gl.FramebufferClear.COLOR)
+
+        # At least the oldest frame got retrieved when the ring wrapped around
+        self.assertGreaterEqual(a.duration, 0.0)
+
+        a.begin()
+        with self.assertRaisesRegex(RuntimeError, "the timer is already running"):
+            a.begin()
+        a.end()
+        with self.assertRaisesRegex(RuntimeError, "the timer is not running"):
+            a.end()
+
+    def test_frame_timer_invalid(self):
+        with self.assertRaisesRegex(ValueError, "delay has to be at least one frame"):
+            gl.FrameTimer(delay=0)
+
 class Renderbuffer(GLTestCase):
     def test_init(self):
         renderbuffer = gl.Renderbuffer()
@@ -285,6 +678,35 @@ class Renderer(GLTestCase):
     def test_error(self):
         self.assertEqual(gl.Renderer.error, gl.Renderer.Error.NO_ERROR)
 
+    def test_statistics(self):
+        gl.Renderer.statistics_enabled = True
+        self.assertTrue(gl.Renderer.statistics_enabled)
+        gl.Renderer.reset_statistics()
+
+        gl.Renderer.enable(gl.Renderer.Feature.DEPTH_TEST)
+        gl.Renderer.enable(gl.Renderer.Feature.DEPTH_TEST)
+        gl.Renderer.set_feature(gl.Renderer.Feature.DEPTH_TEST, False)
+        gl.Renderer.clear_color = Color4(0.5)
+        gl.Renderer.clear_color = Color4(0.5)
+        gl.default_framebuffer.bind()
+        gl.Texture2D().bind(0)
+
+        statistics = gl.Renderer.statistics
+        self.assertEqual(statistics['state_changes'], 3)
+        self.assertEqual(statistics['redundant_state_changes'], 2)
+        self.assertEqual(statistics['framebuffer_binds'], 1)
+        self.assertEqual(statistics['texture_binds'], 1)
+        self.assertEqual(statistics['draw_calls'], 0)
+        self.assertEqual(statistics['program_switches'], 0)
+
+        gl.Renderer.reset_statistics()
+        self.assertEqual(gl.Renderer.statistics['state_changes'], 0)
+
+        # Nothing gets counted when disabled
+        gl.Renderer.statistics_enabled = False
+        gl.Renderer.enable(gl.Renderer.Feature.DEPTH_TEST)
+        self.assertEqual(gl.Renderer.statistics['state_changes'], 0)
+
 class Shader(GLTestCase):
     def test(self):
         if magnum.TARGET_GLES2:
@@ -311,6 +733,23 @@ class Shader(GLTestCase):
         with self.assertRaisesRegex(RuntimeError, "compilation failed"):
             a.compile()
 
+    def test_compile_async(self):
+        version = gl.Version.GLES200 if magnum.TARGET_GLES2 else gl.Version.GLES300 if magnum.TARGET_GLES else gl.Version.GL300
+        a = gl.Shader(version, gl.Shader.Type.VERTEX)
+        a.add_source("""
+        void main() {
+            gl_Position = vec4(0.0);
+        }
+        """)
+        b = gl.Shader(version, gl.Shader.Type.VERTEX)
+        b.add_source("error!!!!")
+
+        gl.Shader.compile_all([a, b])
+        while not a.compile_finished: pass
+        a.check_compile()
+        with self.assertRaisesRegex(RuntimeError, "compilation failed"):
+            b.check_compile()
+
 class AbstractTexture(GLTestCase):
     def test_unbind(self):
         gl.AbstractTexture.unbind(3)
@@ -419,3 +858,178 @@ class Texture(GLTestCase):
             # This is in ES3.2 too, but we don't have a way to check for
             # extensions / version yet
             self.assertEqual(a.image_size(0), Vector2i(16, 16))
+
+    def test_set_sub_image_tiles(self):
+        # A 8x4 RGBA image uploaded as two 4x4 tiles directly from the
+        # original memory, without repacking
+        data = bytearray(range(8*4*4))
+
+        a = gl.Texture2D()
+        a.set_storage(levels=1, internal_format=gl.TextureFormat.RGBA8,
+            size=Vector2i(8, 4))
+        for x in [0, 4]:
+            storage = PixelStorage()
+            storage.row_length = 8
+            storage.skip = (x, 0, 0)
+            a.set_sub_image(0, Vector2i(x, 0), ImageView2D(storage, PixelFormat.RGBA8_UNORM, Vector2i(4, 4), data))
+
+        # Read the texture back through a framebuffer, each tile should have
+        # the pixels of the corresponding part of the original image
+        framebuffer = gl.Framebuffer(((0, 0), (8, 4)))
+        framebuffer.attach_texture(gl.Framebuffer.ColorAttachment(0), a, 0)
+        image = Image2D(PixelFormat.RGBA8_UNORM)
+        framebuffer.read(Range2Di.from_size((0, 0), (8, 4)), image)
+        self.assertEqual(image.size, Vector2i(8, 4))
+        for y in range(4):
+            for x in range(8):
+                for c in range(4):
+                    self.assertEqual(ord(image.pixels[y, x, c]), data[(y*8 + x)*4 + c], (x, y, c))
+
+    @unittest.skipIf(magnum.TARGET_GLES2, "buffer images are not available on ES2")
+    def test_set_image_buffer(self):
+        image = gl.BufferImage2D(PixelFormat.RGBA8_UNORM)
+        image.set_data(PixelFormat.RGBA8_UNORM, Vector2i(4, 4), bytes(64), gl.BufferUsage.STREAM_DRAW)
+        self.assertEqual(image.size, Vector2i(4, 4))
+        self.assertEqual(image.data_size, 64)
+
+        a = gl.Texture2D()
+        a.set_image(0, gl.TextureFormat.RGBA8, image)
+        a.set_sub_image(0, Vector2i(), image)
+
+@unittest.skipIf(magnum.TARGET_GLES2, "texture arrays are not available on ES2")
+class TextureArray(GLTestCase):
+    def test_sampler(self):
+        a = gl.Texture2DArray()
+        a.minification_filter = (SamplerFilter.LINEAR, SamplerMipmap.LINEAR)
+        a.magnification_filter = SamplerFilter.LINEAR
+        a.wrapping = SamplerWrapping.CLAMP_TO_EDGE
+
+    def test_set_storage_subimage(self):
+        a = gl.Texture2DArray()
+        a.set_storage(levels=3, internal_format=gl.TextureFormat.RGBA8,
+            size=Vector3i(4, 4, 16))
+
+        # Upload just a single layer
+        a.set_sub_image(0, Vector3i(0, 0, 7), ImageView3D(PixelFormat.RGBA8_UNORM, Vector3i(4, 4, 1), bytearray(64)))
+        a.generate_mipmap()
+
+        if not magnum.TARGET_GLES:
+            self.assertEqual(a.image_size(0), Vector3i(4, 4, 16))
+
+class CubeMapTexture(GLTestCase):
+    def test_sampler(self):
+        a = gl.CubeMapTexture()
+        a.minification_filter = SamplerFilter.LINEAR
+        a.magnification_filter = gl.SamplerFilter.LINEAR
+        a.wrapping = SamplerWrapping.CLAMP_TO_EDGE
+
+    def test_set_storage_subimage(self):
+        a = gl.CubeMapTexture()
+        a.set_storage(levels=1, internal_format=gl.TextureFormat.RGBA8,
+            size=Vector2i(4))
+        for coordinate in [gl.CubeMapCoordinate.POSITIVE_X,
+                           gl.CubeMapCoordinate.NEGATIVE_X,
+                           gl.CubeMapCoordinate.POSITIVE_Y,
+                           gl.CubeMapCoordinate.NEGATIVE_Y,
+                           gl.CubeMapCoordinate.POSITIVE_Z,
+                           gl.CubeMapCoordinate.NEGATIVE_Z]:
+            a.set_sub_image(coordinate, 0, Vector2i(), ImageView2D(PixelFormat.RGBA8_UNORM, Vector2i(4), bytearray(64)))
+
+        if not magnum.TARGET_GLES:
+            self.assertEqual(a.image_size(0), Vector2i(4, 4))
+
+# TODO: re-enable on ES when extensions can be checked
+@unittest.skipUnless(not magnum.TARGET_GLES, "buffer textures are not available on WebGL and require an extension on ES which we can't check")
+class BufferTexture(GLTestCase):
+    def test_set_buffer(self):
+        buffer = gl.Buffer(gl.Buffer.TargetHint.TEXTURE)
+        buffer.set_data(bytearray(64))
+        buffer_refcount = sys.getrefcount(buffer)
+
+        a = gl.BufferTexture()
+        self.assertIsNone(a.buffer)
+        a.set_buffer(gl.BufferTextureFormat.RGBA8, buffer)
+        self.assertEqual(a.size, 16)
+
+        # The texture keeps a reference to the buffer
+        self.assertIs(a.buffer, buffer)
+        self.assertEqual(sys.getrefcount(buffer), buffer_refcount + 1)
+
+        # Setting it again replaces the reference instead of adding another
+        a.set_buffer(gl.BufferTextureFormat.RGBA8, buffer, 0, 32)
+        self.assertEqual(a.size, 8)
+        self.assertEqual(sys.getrefcount(buffer), buffer_refcount + 1)
+
+        # Setting a different buffer releases the previous one
+        another = gl.Buffer(gl.Buffer.TargetHint.TEXTURE)
+        another.set_data(bytearray(16))
+        a.set_buffer(gl.BufferTextureFormat.RGBA8, another)
+        self.assertIs(a.buffer, another)
+        self.assertEqual(sys.getrefcount(buffer), buffer_refcount)
+
+        a.set_buffer(gl.BufferTextureFormat.RGBA8, buffer)
+        self.assertEqual(sys.getrefcount(buffer), buffer_refcount + 1)
+        del a
+        self.assertEqual(sys.getrefcount(buffer), buffer_refcount)
+
+@unittest.skipIf(magnum.TARGET_GLES2, "transform feedback is not available on ES2")
+class TransformFeedback(GLTestCase):
+    def test(self):
+        version = gl.Version.GLES300 if magnum.TARGET_GLES else gl.Version.GL300
+        program = gl.AbstractShaderProgram()
+
+        vert = gl.Shader(version, gl.Shader.Type.VERTEX)
+        vert.add_source("""
+out highp float result;
+
+void main() {
+    result = float(gl_VertexID)*2.0;
+    gl_Position = vec4(0.0);
+}
+        """.strip())
+        vert.compile()
+        program.attach_shader(vert)
+
+        frag = gl.Shader(version, gl.Shader.Type.FRAGMENT)
+        frag.add_source("""
+out lowp vec4 color;
+
+void main() {
+    color = vec4(0.0);
+}
+        """.strip())
+        frag.compile()
+        program.attach_shader(frag)
+
+        program.set_transform_feedback_outputs(["result"], gl.AbstractShaderProgram.TransformFeedbackBufferMode.INTERLEAVED_ATTRIBUTES)
+        program.link()
+
+        buffer = gl.Buffer()
+        buffer.set_data(b'\x00'*16, gl.BufferUsage.STATIC_READ)
+        buffer_refcount = sys.getrefcount(buffer)
+
+        xfb = gl.TransformFeedback()
+        xfb.attach_buffer(0, buffer)
+        self.assertEqual(xfb.buffers, [buffer])
+        self.assertEqual(sys.getrefcount(buffer), buffer_refcount + 1)
+
+        # Attaching again to the same index replaces the reference
+        xfb.attach_buffer(0, buffer, 0, 16)
+        self.assertEqual(sys.getrefcount(buffer), buffer_refcount + 1)
+
+        mesh = gl.Mesh(gl.MeshPrimitive.POINTS)
+        mesh.count = 4
+
+        gl.Renderer.enable(gl.Renderer.Feature.RASTERIZER_DISCARD)
+        xfb.begin(program, gl.TransformFeedback.PrimitiveMode.POINTS)
+        program.draw(mesh)
+        xfb.end()
+        gl.Renderer.disable(gl.Renderer.Feature.RASTERIZER_DISCARD)
+
+        view = buffer.map(0, 16, gl.Buffer.MapFlag.READ)
+        self.assertEqual(list(array.array('f', bytes(view))), [0.0, 2.0, 4.0, 6.0])
+        del view
+        buffer.unmap()
+
+        del xfb
+        self.assertEqual(sys.getrefcount(buffer), buffer_refcount)
@@ -0,0 +1,152 @@
+#
+#   This file is part of Magnum.
+#
+#   Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+#             Vladimír Vondruš <mosra@centrum.cz>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a
+#   copy of this software and associated documentation files (the "Software"),
+#   to deal in the Software without restriction, including without limitation
+#   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#   and/or sell copies of the Software, and to permit persons to whom the
+#   Software is furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included
+#   in all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+#   DEALINGS IN THE SOFTWARE.
+#
+
+import sys
+import threading
+import unittest
+
+# setUpModule gets called before everything else, skipping if GL tests can't
+# be run
+from . import GLTestCase, setUpModule
+
+from magnum import *
+from magnum import gl
+
+try:
+    from magnum.platform import egl
+except ImportError:
+    egl = None
+
+try:
+    from magnum.platform.glx import WindowlessContext
+except ImportError:
+    try:
+        from magnum.platform.egl import WindowlessContext
+    except ImportError:
+        WindowlessContext = None
+
+@unittest.skipIf(not WindowlessContext, "no WindowlessContext found")
+class Context(GLTestCase):
+    def test(self):
+        # The context gets made current in the thread that creates it, so do
+        # it all in a separate thread to not disturb the test application
+        results = []
+        def worker():
+            try:
+                context = WindowlessContext()
+
+                renderbuffer = gl.Renderbuffer()
+                renderbuffer.set_storage(gl.RenderbufferFormat.RGBA8, (2, 2))
+                framebuffer = gl.Framebuffer(((0, 0), (2, 2)))
+                framebuffer.attach_renderbuffer(gl.Framebuffer.ColorAttachment(0), renderbuffer)
+                gl.Renderer.clear_color = Color4(0.0, 1.0, 0.0)
+                framebuffer.clear(gl.FramebufferClear.COLOR)
+                image = Image2D(PixelFormat.RGBA8_UNORM)
+                framebuffer.read(Range2Di.from_size((0, 0), (2, 2)), image)
+                results.append(ord(image.pixels[1, 1, 1]))
+                del renderbuffer, framebuffer, image
+
+                WindowlessContext.release()
+                results.append(context.make_current())
+                WindowlessContext.release()
+            except Exception as e:
+                results.append(e)
+
+        thread = threading.Thread(target=worker)
+        thread.start()
+        thread.join()
+        self.assertEqual(results, [0xff, True])
+
+    def test_statistics_state(self):
+        gl.Renderer.statistics_enabled = True
+        gl.Renderer.reset_statistics()
+        gl.Renderer.enable(gl.Renderer.Feature.DEPTH_TEST)
+
+        # The redundant state tracking is done for each context separately,
+        # so enabling the same feature in another context isn't redundant
+        results = []
+        def worker():
+            try:
+                context = WindowlessContext()
+                gl.Renderer.enable(gl.Renderer.Feature.DEPTH_TEST)
+                gl.Renderer.enable(gl.Renderer.Feature.DEPTH_TEST)
+                WindowlessContext.release()
+            except Exception as e:
+                results.append(e)
+
+        try:
+            thread = threading.Thread(target=worker)
+            thread.start()
+            thread.join()
+            self.assertEqual(results, [])
+
+            # The counters are shared by all contexts
+            statistics = gl.Renderer.statistics
+            self.assertEqual(statistics['state_changes'], 2)
+            self.assertEqual(statistics['redundant_state_changes'], 1)
+        finally:
+            gl.Renderer.statistics_enabled = False
+
+@unittest.skipIf(not egl, "EGL platform integration not available")
+class RenderTarget(GLTestCase):
+    def test(self):
+        target = egl.RenderTarget((4, 2))
+        self.assertEqual(target.size, Vector2i(4, 2))
+
+        called = []
+        gl.Renderer.clear_color = Color4(1.0, 0.5, 0.75)
+        image = target.render(lambda: called.append(True))
+        self.assertEqual(called, [True])
+        self.assertEqual(image.size, Vector2i(4, 2))
+        self.assertEqual(image.format, PixelFormat.RGBA8_UNORM)
+        for y in range(2):
+            for x in range(4):
+                self.assertEqual(ord(image.pixels[y, x, 0]), 0xff)
+                self.assertEqual(ord(image.pixels[y, x, 1]), 0x80)
+                self.assertEqual(ord(image.pixels[y, x, 2]), 0xbf)
+                self.assertEqual(ord(image.pixels[y, x, 3]), 0xff)
+
+    def test_storage_reused(self):
+        target = egl.RenderTarget((2, 2))
+        target_refcount = sys.getrefcount(target)
+
+        gl.Renderer.clear_color = Color4(1.0, 0.0, 0.0)
+        image = target.render(lambda: None)
+        self.assertIs(image.owner, target)
+        self.assertEqual(sys.getrefcount(target), target_refcount + 1)
+        self.assertEqual(ord(image.pixels[1, 1, 0]), 0xff)
+
+        # The next render overwrites the data the previous image points to
+        gl.Renderer.clear_color = Color4(0.0, 1.0, 0.0)
+        target.render(lambda: None)
+        self.assertEqual(ord(image.pixels[1, 1, 0]), 0x00)
+        self.assertEqual(ord(image.pixels[1, 1, 1]), 0xff)
+
+        del image
+        self.assertEqual(sys.getrefcount(target), target_refcount)
+
+    def test_invalid_size(self):
+        with self.assertRaisesRegex(ValueError, "expected a non-zero size"):
+            egl.RenderTarget((0, 2))
@@ -28,7 +28,7 @@ import unittest
 
 from magnum import *
 from magnum import scenegraph
-from magnum.scenegraph.matrix import Object3D, Scene3D
+from magnum.scenegraph.matrix import Object3D, Object3Dd, Scene3D, Scene3Dd
 
 class Object(unittest.TestCase):
     def test_hierarchy(self):
@@ -116,6 +116,110 @@ class Object(unittest.TestCase):
         with self.assertRaisesRegex(TypeError, "expected Scene, Object or None, got <class 'str'>"):
             a.parent = "noo"
 
+    def test_reparent(self):
+        scene = Scene3D()
+        a = Object3D()
+        b = Object3D()
+        a_refcount = sys.getrefcount(a)
+        b_refcount = sys.getrefcount(b)
+
+        # Both should get referenced by the scene
+        Object3D.reparent([a, b], scene)
+        self.assertIs(a.parent, scene)
+        self.assertIs(b.parent, scene)
+        self.assertEqual(sys.getrefcount(a), a_refcount + 1)
+        self.assertEqual(sys.getrefcount(b), b_refcount + 1)
+
+        # Moving between parents doesn't change the refcount
+        c = Object3D(scene)
+        Object3D.reparent([a, b], c)
+        self.assertIs(a.parent, c)
+        self.assertIs(b.scene, scene)
+        self.assertEqual(sys.getrefcount(a), a_refcount + 1)
+
+        # And removing the parent releases the reference again
+        Object3D.reparent([a, b], None)
+        self.assertIsNone(a.parent)
+        self.assertIsNone(b.parent)
+        self.assertEqual(sys.getrefcount(a), a_refcount)
+        self.assertEqual(sys.getrefcount(b), b_refcount)
+
+    def test_reparent_invalid(self):
+        a = Object3D()
+        b = Object3D(a)
+        c = Object3D()
+
+        with self.assertRaisesRegex(TypeError, "expected Scene, Object or None, got <class 'str'>"):
+            Object3D.reparent([a], "noo")
+        with self.assertRaisesRegex(ValueError, "can't make an object a child of itself or its descendant"):
+            Object3D.reparent([c, a], b)
+        with self.assertRaisesRegex(ValueError, "can't make an object a child of itself or its descendant"):
+            Object3D.reparent([a], a)
+
+        # Nothing got changed
+        self.assertIsNone(a.parent)
+        self.assertIsNone(c.parent)
+
+    def test_destroy_subtree(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        b = Object3D(a)
+        c = Object3D(b)
+        d = Object3D(scene)
+        a_refcount = sys.getrefcount(a)
+        c_refcount = sys.getrefcount(c)
+
+        # B is referenced only by its parent, so it gets deleted. A and C are
+        # referenced from here, so they're just orphaned.
+        del b
+        a.destroy_subtree()
+        self.assertIsNone(a.parent)
+        self.assertIsNone(c.parent)
+        self.assertEqual(sys.getrefcount(a), a_refcount - 1)
+        self.assertEqual(sys.getrefcount(c), c_refcount - 1)
+
+        # D is not a part of the subtree
+        self.assertIs(d.parent, scene)
+
+    def test_dirty(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        b = Object3D(a)
+        a.set_clean()
+        b.set_clean()
+        self.assertFalse(a.is_dirty)
+        self.assertFalse(b.is_dirty)
+
+        # Transforming the parent makes children dirty as well
+        a.translate((1.0, 0.0, 0.0))
+        self.assertTrue(a.is_dirty)
+        self.assertTrue(b.is_dirty)
+
+        scene.set_clean([b])
+        self.assertFalse(a.is_dirty)
+        self.assertFalse(b.is_dirty)
+
+        b.set_dirty()
+        self.assertTrue(b.is_dirty)
+        self.assertFalse(a.is_dirty)
+
+    def test_cached_transformation(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        b = Object3D(a)
+        b.translate((0.0, 2.0, 0.0))
+
+        cached = scenegraph.CachedTransformation3D(b)
+        self.assertIs(cached.object, b)
+        self.assertEqual(cached.absolute_transformation_matrix,
+            Matrix4.translation((0.0, 2.0, 0.0)))
+        self.assertFalse(b.is_dirty)
+
+        a.translate((1.0, 0.0, 0.0))
+        self.assertTrue(b.is_dirty)
+        self.assertEqual(cached.absolute_transformation_matrix,
+            Matrix4.translation((1.0, 2.0, 0.0)))
+
     def test_drawable(self):
         object = Object3D()
         object_refcount = sys.getrefcount(object)
@@ -163,6 +267,10 @@ class Object(unittest.TestCase):
         self.assertEqual(deleted, 0)
         self.assertEqual(len(drawables), 2)
 
+        # Removing one from the group
+        drawables.remove(drawables[1])
+        self.assertEqual(len(drawables), 1)
+
         # Deleting the holder object will, tho
         del object
         self.assertEqual(deleted, 2)
@@ -243,6 +351,83 @@ class Object(unittest.TestCase):
         self.assertIsNone(camera.object)
         self.assertIs(len(drawables), 0)
 
+    def test_camera_draw_cull_sort(self):
+        scene = Scene3D()
+        drawables = scenegraph.DrawableGroup3D()
+
+        camera_object = Object3D(scene)
+        camera_object.translate((0.0, 0.0, 5.0))
+
+        camera = scenegraph.Camera3D(camera_object)
+        camera.projection_matrix = Matrix4.perspective_projection(
+            fov=Deg(45.0), near=0.01, far=100.0, aspect_ratio=1.0)
+
+        rendered = []
+        class MyDrawable(scenegraph.Drawable3D):
+            def draw(self, transformation_matrix: Matrix4, camera: scenegraph.Camera3D):
+                rendered.append(self)
+
+        far = Object3D(scene)
+        near = Object3D(scene)
+        near.translate((0.0, 0.0, 2.0))
+        outside = Object3D(scene)
+        outside.translate((100.0, 0.0, 0.0))
+
+        a = MyDrawable(far, drawables)
+        a.bounds = Range3D((-1.0, -1.0, -1.0), (1.0, 1.0, 1.0))
+        a.sort_key = 1
+        b = MyDrawable(near, drawables)
+        b.bounds = Range3D((-1.0, -1.0, -1.0), (1.0, 1.0, 1.0))
+        b.sort_key = 2
+        c = MyDrawable(outside, drawables)
+        c.bounds = Range3D((-1.0, -1.0, -1.0), (1.0, 1.0, 1.0))
+        c.sort_key = 0
+        self.assertEqual(b.bounds, Range3D((-1.0, -1.0, -1.0), (1.0, 1.0, 1.0)))
+        self.assertEqual(b.sort_key, 2)
+
+        camera.draw(drawables, cull=True, order=scenegraph.DrawOrder.FRONT_TO_BACK)
+        self.assertEqual(rendered, [b, a])
+
+        rendered = []
+        camera.draw(drawables, order=scenegraph.DrawOrder.SORT_KEY)
+        self.assertEqual(rendered, [c, a, b])
+
+        # Drawables without bounds are never culled
+        rendered = []
+        c.bounds = None
+        self.assertIsNone(c.bounds)
+        camera.draw(drawables, cull=True)
+        self.assertEqual(rendered, [a, b, c])
+
+    def test_camera_draw_double(self):
+        scene = Scene3Dd()
+        drawables = scenegraph.DrawableGroup3Dd()
+
+        # Far enough from the origin for floats to not have any fractional
+        # part anymore
+        camera_object = Object3Dd(scene)
+        camera_object.translate((1.0e8, 0.0, 5.0))
+        camera = scenegraph.Camera3Dd(camera_object)
+
+        rendered = None
+        class MyDrawable(scenegraph.Drawable3Dd):
+            def draw(self, transformation_matrix: Matrix4d, camera: scenegraph.Camera3Dd):
+                nonlocal rendered
+                rendered = transformation_matrix
+
+        object = Object3Dd(scene)
+        object.translate((1.0e8 + 0.25, 0.0, 0.0))
+        a = MyDrawable(object, drawables)
+        a.bounds = Range3Dd((-1.0, -1.0, -1.0), (1.0, 1.0, 1.0))
+        self.assertIs(a.object, object)
+        self.assertIs(object.scene, scene)
+
+        # The transformation is relative to the camera, without the precision
+        # loss
+        camera.draw(drawables)
+        self.assertEqual(rendered.translation, Vector3d(0.25, 0.0, -5.0))
+        self.assertEqual(Matrix4(rendered).translation, Vector3(0.25, 0.0, -5.0))
+
 class Feature(unittest.TestCase):
     def test(self):
         class MyFeature(scenegraph.AbstractFeature3D):
@@ -252,3 +437,189 @@ class Feature(unittest.TestCase):
         object = Object3D()
         feature = MyFeature(object)
         self.assertIs(feature.object, object)
+
+class Scene(unittest.TestCase):
+    def test_absolute_transformation_matrices(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        a.translate((1.0, 2.0, 3.0))
+        b = Object3D(a)
+        b.scale((2.0, 2.0, 2.0))
+        c = Object3D(scene)
+
+        matrices = scene.absolute_transformation_matrices([b, c, a])
+        self.assertEqual(matrices.format, 'f')
+        self.assertEqual(matrices.shape, (3, 4, 4))
+        # Rows first, like with numpy arrays
+        self.assertEqual(matrices.tolist()[0], [
+            [2.0, 0.0, 0.0, 1.0],
+            [0.0, 2.0, 0.0, 2.0],
+            [0.0, 0.0, 2.0, 3.0],
+            [0.0, 0.0, 0.0, 1.0]])
+        self.assertEqual(matrices.tolist()[1], [
+            [1.0, 0.0, 0.0, 0.0],
+            [0.0, 1.0, 0.0, 0.0],
+            [0.0, 0.0, 1.0, 0.0],
+            [0.0, 0.0, 0.0, 1.0]])
+
+        # Columns contiguous in memory, same as the matrix array inputs
+        # expect, so passing the output back doesn't make a copy
+        self.assertEqual(matrices.strides, (64, 4, 16))
+        self.assertTrue(scenegraph._is_matrix4_array_view(matrices))
+
+    def test_absolute_transformation_matrices_invalid(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        b = Object3D()
+
+        with self.assertRaisesRegex(ValueError, "object 1 is not a part of this scene"):
+            scene.absolute_transformation_matrices([a, b])
+
+    def test_all_absolute_transformation_matrices(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        a.translate((1.0, 0.0, 0.0))
+        b = Object3D(a)
+        b.translate((0.0, 1.0, 0.0))
+        c = Object3D(scene)
+
+        objects, matrices = scene.all_absolute_transformation_matrices()
+        self.assertEqual(len(objects), 3)
+        self.assertEqual(matrices.shape, (3, 4, 4))
+        for i, object in enumerate(objects):
+            translation = Vector4(*[row[3] for row in matrices.tolist()[i]])
+            self.assertEqual(translation,
+                object.absolute_transformation_matrix()[3])
+
+        # Parents are always listed before their children
+        self.assertLess(objects.index(a), objects.index(b))
+        self.assertIn(c, objects)
+
+    def test_clear(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        b = Object3D(a)
+        c = Object3D(scene)
+        b_refcount = sys.getrefcount(b)
+        del a, c
+
+        scene.clear()
+        self.assertIsNone(b.parent)
+        self.assertEqual(sys.getrefcount(b), b_refcount - 1)
+        objects, _ = scene.all_absolute_transformation_matrices()
+        self.assertEqual(objects, [])
+
+class DrawableBvh(unittest.TestCase):
+    def test(self):
+        scene = Scene3D()
+        drawables = scenegraph.DrawableGroup3D()
+
+        class MyDrawable(scenegraph.Drawable3D):
+            def draw(self, transformation_matrix: Matrix4, camera: scenegraph.Camera3D):
+                pass
+
+        objects = []
+        for i in range(10):
+            object = Object3D(scene)
+            object.translate((i*3.0, 0.0, 0.0))
+            drawable = MyDrawable(object, drawables)
+            drawable.bounds = Range3D((-1.0, -1.0, -1.0), (1.0, 1.0, 1.0))
+            objects += [object]
+
+        # Drawables without bounds are not indexed
+        MyDrawable(Object3D(scene), drawables)
+
+        bvh = scenegraph.DrawableBvh3D(drawables)
+        self.assertEqual(len(bvh), 10)
+        self.assertIs(bvh.drawables, drawables)
+        self.assertEqual(bvh.bounds, Range3D((-1.0, -1.0, -1.0), (28.0, 1.0, 1.0)))
+
+        self.assertEqual(bvh.ray_query((-10.0, 0.0, 0.0), (1.0, 0.0, 0.0)), objects)
+        self.assertEqual(bvh.ray_query((6.0, 10.0, 0.0), (0.0, -1.0, 0.0)), [objects[2]])
+        self.assertEqual(bvh.ray_query((6.0, 10.0, 0.0), (0.0, 1.0, 0.0)), [])
+
+        self.assertEqual(bvh.range_query(Range3D((2.5, -1.0, -1.0), (7.0, 1.0, 1.0))), [objects[1], objects[2]])
+
+        self.assertEqual(bvh.nearest((9.2, 0.0, 0.0)), [objects[3]])
+        self.assertEqual(bvh.nearest((9.2, 0.0, 0.0), count=3), [objects[3], objects[4], objects[2]])
+
+        # Refit picks up the changed transformation
+        objects[0].translate((100.0, 0.0, 0.0))
+        bvh.refit()
+        self.assertEqual(bvh.bounds, Range3D((2.0, -1.0, -1.0), (101.0, 1.0, 1.0)))
+        self.assertEqual(bvh.nearest((100.0, 0.0, 0.0)), [objects[0]])
+
+    def test_empty(self):
+        bvh = scenegraph.DrawableBvh3D(scenegraph.DrawableGroup3D())
+        self.assertEqual(len(bvh), 0)
+        self.assertIsNone(bvh.bounds)
+        self.assertEqual(bvh.ray_query((0.0, 0.0, 0.0), (1.0, 0.0, 0.0)), [])
+        self.assertEqual(bvh.range_query(Range3D((-1.0, -1.0, -1.0), (1.0, 1.0, 1.0))), [])
+        self.assertEqual(bvh.nearest((0.0, 0.0, 0.0)), [])
+
+class FlatScene(unittest.TestCase):
+    def test(self):
+        scene = scenegraph.FlatScene3D()
+        self.assertEqual(len(scene), 0)
+
+        a = scene.add()
+        b = scene.add(parent=a)
+        self.assertEqual((a, b), (0, 1))
+        self.assertEqual(scene.extend([0, 1]), 2)
+        self.assertEqual(len(scene), 4)
+        self.assertEqual(scene.parents.tolist(), [-1, 0, 0, 1])
+        self.assertEqual(scene.translations.shape, (4, 3))
+        self.assertEqual(scene.rotations.tolist()[0], [0.0, 0.0, 0.0, 1.0])
+        self.assertEqual(scene.scalings.tolist()[0], [1.0, 1.0, 1.0])
+
+        translations = scene.translations
+        translations[0, 0] = 1.0
+        translations[1, 1] = 2.0
+        scalings = scene.scalings
+        scalings[3, 2] = 3.0
+        del translations, scalings
+        scene.update()
+
+        matrices = scene.world_matrices
+        self.assertEqual(matrices.shape, (4, 4, 4))
+        self.assertEqual([row[3] for row in matrices.tolist()[3]],
+            [1.0, 2.0, 0.0, 1.0])
+        self.assertEqual(matrices.tolist()[3][2][2], 3.0)
+        self.assertEqual([row[3] for row in matrices.tolist()[2]],
+            [1.0, 0.0, 0.0, 1.0])
+
+        # Same layout as absolute_transformation_matrices(), so it can be
+        # passed to draw_batch() without a copy
+        self.assertEqual(matrices.strides, (64, 4, 16))
+        self.assertTrue(scenegraph._is_matrix4_array_view(matrices))
+
+    def test_empty(self):
+        scene = scenegraph.FlatScene3D()
+        scene.update()
+        self.assertEqual(scene.parents.shape, (0,))
+        self.assertEqual(scene.translations.shape, (0, 3))
+        self.assertEqual(scene.rotations.shape, (0, 4))
+        self.assertEqual(scene.scalings.shape, (0, 3))
+        self.assertEqual(scene.world_matrices.shape, (0, 4, 4))
+
+    def test_invalid(self):
+        scene = scenegraph.FlatScene3D()
+        scene.add()
+
+        with self.assertRaisesRegex(ValueError, "parent of object 1 expected to be -1 or less than 1 but got 1"):
+            scene.add(1)
+
+        view = scene.parents
+        with self.assertRaisesRegex(BufferError, "can't add objects while views on the scene arrays exist"):
+            scene.add()
+        del view
+
+        scene.add(0)
+        parents = scene.parents
+        scene.translations[0, 0] = 1.0
+        parents[1] = 5
+        with self.assertRaisesRegex(ValueError, "parent of object 1 expected to be -1 or less than 1 but got 5"):
+            scene.update()
+
+        # Nothing got updated
+        self.assertEqual(scene.world_matrices.tolist()[0][0][3], 0.0)
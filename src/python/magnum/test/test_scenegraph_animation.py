@@ -0,0 +1,79 @@
+#
+#   This file is part of Magnum.
+#
+#   Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+#             Vladimír Vondruš <mosra@centrum.cz>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a
+#   copy of this software and associated documentation files (the "Software"),
+#   to deal in the Software without restriction, including without limitation
+#   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#   and/or sell copies of the Software, and to permit persons to whom the
+#   Software is furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included
+#   in all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+#   DEALINGS IN THE SOFTWARE.
+#
+
+import os
+import unittest
+
+from magnum import *
+from magnum.scenegraph.trs import Object3D, Scene3D
+
+# The animation player is built only if the Trade library is present
+try:
+    from magnum import trade
+    from magnum.scenegraph.trs import AnimationPlayer3D
+except ImportError:
+    raise unittest.SkipTest("magnum.trade not available")
+
+class AnimationPlayer(unittest.TestCase):
+    def test(self):
+        importer = trade.ImporterManager().load_and_instantiate('TinyGltfImporter')
+        importer.open_file(os.path.join(os.path.dirname(__file__), 'animation.gltf'))
+
+        scene = Scene3D()
+        a = Object3D(scene)
+        b = Object3D(scene)
+
+        player = AnimationPlayer3D()
+        player.add(importer.animation(0), [a, b])
+        self.assertEqual(len(player), 2)
+        self.assertEqual(player.duration, Range1D(0.0, 2.0))
+        self.assertEqual(player.state, AnimationPlayer3D.State.STOPPED)
+
+        a.set_clean()
+        player.play(10.0)
+        player.advance(11.0)
+        self.assertEqual(player.state, AnimationPlayer3D.State.PLAYING)
+        self.assertTrue(a.is_dirty)
+        self.assertEqual(a.translation, Vector3(1.0, 2.0, 3.0))
+        self.assertEqual(b.scaling, Vector3(2.0))
+
+    def test_skip_target(self):
+        importer = trade.ImporterManager().load_and_instantiate('TinyGltfImporter')
+        importer.open_file(os.path.join(os.path.dirname(__file__), 'animation.gltf'))
+
+        b = Object3D()
+
+        player = AnimationPlayer3D()
+        player.add(importer.animation(0), [None, b])
+        self.assertEqual(len(player), 1)
+
+    def test_invalid(self):
+        importer = trade.ImporterManager().load_and_instantiate('TinyGltfImporter')
+        importer.open_file(os.path.join(os.path.dirname(__file__), 'animation.gltf'))
+
+        player = AnimationPlayer3D()
+        with self.assertRaisesRegex(ValueError, "track 1 targets object 1 but got only 1 objects"):
+            player.add(importer.animation(0), [Object3D()])
+        self.assertEqual(len(player), 0)
@@ -0,0 +1,123 @@
+#
+#   This file is part of Magnum.
+#
+#   Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+#             Vladimír Vondruš <mosra@centrum.cz>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a
+#   copy of this software and associated documentation files (the "Software"),
+#   to deal in the Software without restriction, including without limitation
+#   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#   and/or sell copies of the Software, and to permit persons to whom the
+#   Software is furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included
+#   in all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+#   DEALINGS IN THE SOFTWARE.
+#
+
+import sys
+import unittest
+
+# setUpModule gets called before everything else, skipping if GL tests can't
+# be run
+from . import GLTestCase, setUpModule
+
+import magnum
+from magnum import *
+from magnum import gl, scenegraph, shaders
+from magnum.scenegraph.matrix import Object3D, Object3Dd, Scene3D, Scene3Dd
+
+def break_link(shader):
+    # A second vertex shader with main() makes the link fail
+    if magnum.TARGET_GLES2:
+        vert = gl.Shader(gl.Version.GLES200, gl.Shader.Type.VERTEX)
+    elif magnum.TARGET_GLES:
+        vert = gl.Shader(gl.Version.GLES300, gl.Shader.Type.VERTEX)
+    else:
+        vert = gl.Shader(gl.Version.GL300, gl.Shader.Type.VERTEX)
+    vert.add_source("void main() {}")
+    vert.compile()
+    shader.attach_shader(vert)
+    shader.link_async()
+
+class MeshDrawable(GLTestCase):
+    def test(self):
+        scene = Scene3D()
+        drawables = scenegraph.DrawableGroup3D()
+
+        camera = scenegraph.Camera3D(Object3D(scene))
+
+        mesh = gl.Mesh()
+        mesh_refcount = sys.getrefcount(mesh)
+        flat = shaders.Flat3D()
+        phong = shaders.Phong()
+
+        object = Object3D(scene)
+        a = scenegraph.MeshDrawable3D(object, drawables, mesh, flat)
+        b = scenegraph.MeshDrawable3D(object, drawables, mesh, phong, Color4(0.5))
+        self.assertIs(a.mesh, mesh)
+        self.assertIs(a.shader, flat)
+        self.assertIs(b.shader, phong)
+        self.assertEqual(a.color, Color4(1.0))
+        self.assertEqual(b.color, Color4(0.5))
+
+        # The drawables keep the mesh alive
+        self.assertEqual(sys.getrefcount(mesh), mesh_refcount + 2)
+
+        # Group item access returns the native type
+        self.assertEqual([i for i in drawables], [a, b])
+        self.assertIsInstance(drawables[0], scenegraph.MeshDrawable3D)
+
+        # The native draws are counted same as draws from Python
+        gl.Renderer.statistics_enabled = True
+        gl.Renderer.reset_statistics()
+        try:
+            camera.draw(drawables)
+            self.assertEqual(gl.Renderer.statistics['draw_calls'], 2)
+            self.assertEqual(gl.Renderer.statistics['program_switches'], 2)
+        finally:
+            gl.Renderer.statistics_enabled = False
+
+        drawables.remove(a)
+        self.assertEqual([i for i in drawables], [b])
+
+    def test_double(self):
+        scene = Scene3Dd()
+        drawables = scenegraph.DrawableGroup3Dd()
+
+        camera_object = Object3Dd(scene)
+        camera_object.translate((1.0e7, 0.0, 5.0))
+        camera = scenegraph.Camera3Dd(camera_object)
+
+        object = Object3Dd(scene)
+        object.translate((1.0e7, 0.0, 0.0))
+        a = scenegraph.MeshDrawable3Dd(object, drawables, gl.Mesh(), shaders.Phong())
+        self.assertIsInstance(drawables[0], scenegraph.MeshDrawable3Dd)
+
+        camera.draw(drawables)
+
+    def test_link_async(self):
+        scene = Scene3D()
+        drawables = scenegraph.DrawableGroup3D()
+        camera = scenegraph.Camera3D(Object3D(scene))
+
+        phong = shaders.Phong()
+        break_link(phong)
+        object = Object3D(scene)
+        a = scenegraph.MeshDrawable3D(object, drawables, gl.Mesh(), phong)
+
+        # The native draw checks the pending link first, same as draw()
+        with self.assertRaisesRegex(RuntimeError, "linking failed"):
+            camera.draw(drawables)
+
+    def test_invalid_shader(self):
+        with self.assertRaisesRegex(TypeError, "expected Flat3D or Phong, got <class '.*VertexColor3D'>"):
+            scenegraph.MeshDrawable3D(Object3D(), None, gl.Mesh(), shaders.VertexColor3D())
@@ -61,3 +61,64 @@ class Object(unittest.TestCase):
         c = Object3D(scene)
         self.assertEqual(c.transformation, Matrix4.identity_init())
         self.assertEqual(c.absolute_transformation(), Matrix4.identity_init())
+
+class Scene(unittest.TestCase):
+    def test_absolute_transformation_matrices(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        a.translate((1.0, 2.0, 3.0))
+        b = Object3D(a)
+        b.rotate_x(Deg(35.0))
+
+        matrices = np.array(scene.absolute_transformation_matrices([a, b]), copy=False)
+        self.assertEqual(matrices.shape, (2, 4, 4))
+        self.assertEqual(Matrix4(matrices[1]), b.absolute_transformation_matrix())
+
+    def test_absolute_transformation_matrices_no_copy(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        a.translate((1.0, 2.0, 3.0))
+
+        matrices = np.array(scene.absolute_transformation_matrices([a, a]), copy=False)
+        self.assertEqual(matrices.strides, (64, 4, 16))
+        self.assertTrue(scenegraph._is_matrix4_array_view(matrices))
+
+        # A C-contiguous array has rows contiguous and has to be converted,
+        # a transposed one has columns contiguous and is used directly
+        self.assertFalse(scenegraph._is_matrix4_array_view(np.ascontiguousarray(matrices)))
+        self.assertTrue(scenegraph._is_matrix4_array_view(np.ascontiguousarray(matrices.transpose(0, 2, 1)).transpose(0, 2, 1)))
+
+class FlatScene(unittest.TestCase):
+    def test(self):
+        scene = scenegraph.FlatScene3D()
+        scene.extend(np.array([-1, 0, 1], dtype='int32'))
+
+        translations = np.array(scene.translations, copy=False)
+        translations[:] = [1.0, 0.0, 0.0]
+        rotations = np.array(scene.rotations, copy=False)
+        rotations[1] = [0.0, 0.0, 0.7071068, 0.7071068]
+        del translations, rotations
+        scene.update()
+
+        matrices = np.array(scene.world_matrices, copy=False)
+        self.assertEqual(Matrix4(matrices[2]),
+            Matrix4.translation((1.0, 0.0, 0.0))@
+            Matrix4.translation((1.0, 0.0, 0.0))@
+            Matrix4.rotation_z(Deg(90.0))@
+            Matrix4.translation((1.0, 0.0, 0.0)))
+
+    def test_extend_int64(self):
+        scene = scenegraph.FlatScene3D()
+        self.assertEqual(scene.extend(np.array([-1, 0, 1])), 0)
+        self.assertEqual(scene.extend(np.array([2], dtype='uint8')), 3)
+        self.assertEqual(scene.parents.tolist(), [-1, 0, 1, 2])
+
+    def test_extend_invalid(self):
+        scene = scenegraph.FlatScene3D()
+        with self.assertRaisesRegex(ValueError, "parent 1 doesn't fit into a 32-bit integer"):
+            scene.extend(np.array([-1, 2**40]))
+        with self.assertRaisesRegex(BufferError, "expected an integer format but got d"):
+            scene.extend(np.array([-1.0]))
+        with self.assertRaisesRegex(BufferError, "expected 1 dimensions but got 2"):
+            scene.extend(np.array([[-1]]))
+        self.assertEqual(len(scene), 0)
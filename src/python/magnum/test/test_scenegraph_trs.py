@@ -23,12 +23,13 @@
 #   DEALINGS IN THE SOFTWARE.
 #
 
+import array
 import sys
 import unittest
 
 from magnum import *
 from magnum import scenegraph
-from magnum.scenegraph.trs import Object3D, Scene3D
+from magnum.scenegraph.trs import Object3D, Object3Dd, Scene3D, Scene3Dd
 
 class Object(unittest.TestCase):
     def test(self):
@@ -49,3 +50,46 @@ class Object(unittest.TestCase):
         c = Object3D(scene)
         self.assertEqual(c.transformation, Matrix4.identity_init())
         self.assertEqual(c.absolute_transformation(), Matrix4.identity_init())
+
+    def test_batch(self):
+        scene = Scene3D()
+        a = Object3D(scene)
+        b = Object3D(scene)
+        a.set_clean()
+        b.set_clean()
+
+        Object3D.set_translations([a, b], memoryview(array.array('f', [1.0, 2.0, 3.0, 4.0, 5.0, 6.0])).cast('B').cast('f', [2, 3]))
+        Object3D.set_rotations([b], memoryview(array.array('d', [0.0, 0.0, 0.7071068, 0.7071068])).cast('B').cast('d', [1, 4]))
+        Object3D.set_scalings([a], memoryview(array.array('f', [2.0, 2.0, 2.0])).cast('B').cast('f', [1, 3]))
+        self.assertTrue(a.is_dirty)
+        self.assertTrue(b.is_dirty)
+        self.assertEqual(a.translation, Vector3(1.0, 2.0, 3.0))
+        self.assertEqual(b.translation, Vector3(4.0, 5.0, 6.0))
+        self.assertEqual(b.rotation, Quaternion.rotation(Deg(90.0), Vector3.z_axis()))
+        self.assertEqual(a.scaling, Vector3(2.0))
+
+        translations = Object3D.translations([b, a])
+        self.assertEqual(translations.shape, (2, 3))
+        self.assertEqual(translations.tolist(), [[4.0, 5.0, 6.0], [1.0, 2.0, 3.0]])
+        rotations = Object3D.rotations([a])
+        self.assertEqual(rotations.tolist(), [[0.0, 0.0, 0.0, 1.0]])
+        self.assertEqual(Object3D.scalings([a]).tolist(), [[2.0, 2.0, 2.0]])
+
+    def test_double(self):
+        scene = Scene3Dd()
+        a = Object3Dd(scene)
+        a.translation = Vector3d(1.0e8, 0.0, 0.25)
+        a.rotation = Quaterniond.rotation(Deg(90.0), Vector3d.z_axis())
+        self.assertEqual(a.translation, Vector3d(1.0e8, 0.0, 0.25))
+        self.assertEqual(a.absolute_transformation_matrix().translation, Vector3d(1.0e8, 0.0, 0.25))
+
+        translations = Object3Dd.translations([a])
+        self.assertEqual(translations.format, 'd')
+        self.assertEqual(translations.tolist(), [[1.0e8, 0.0, 0.25]])
+
+    def test_batch_invalid(self):
+        a = Object3D()
+        with self.assertRaisesRegex(ValueError, "expected 1 translations but got 2"):
+            Object3D.set_translations([a], memoryview(array.array('f', [0.0]*6)).cast('B').cast('f', [2, 3]))
+        with self.assertRaisesRegex(BufferError, "expected 4 components but got 3"):
+            Object3D.set_rotations([a], memoryview(array.array('f', [0.0]*3)).cast('B').cast('f', [1, 3]))
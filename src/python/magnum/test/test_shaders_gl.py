@@ -23,14 +23,29 @@
 #   DEALINGS IN THE SOFTWARE.
 #
 
+import array
 import unittest
 
 # setUpModule gets called before everything else, skipping if GL tests can't
 # be run
 from . import GLTestCase, setUpModule
 
+import magnum
 from magnum import *
-from magnum import gl, shaders
+from magnum import gl, meshtools, primitives, shaders
+
+def break_link(shader):
+    # A second vertex shader with main() makes the link fail
+    if magnum.TARGET_GLES2:
+        vert = gl.Shader(gl.Version.GLES200, gl.Shader.Type.VERTEX)
+    elif magnum.TARGET_GLES:
+        vert = gl.Shader(gl.Version.GLES300, gl.Shader.Type.VERTEX)
+    else:
+        vert = gl.Shader(gl.Version.GL300, gl.Shader.Type.VERTEX)
+    vert.add_source("void main() {}")
+    vert.compile()
+    shader.attach_shader(vert)
+    shader.link_async()
 
 class Flat(GLTestCase):
     def test_init(self):
@@ -59,6 +74,104 @@ class Flat(GLTestCase):
         with self.assertRaisesRegex(AttributeError, "the shader was not created with texturing enabled"):
             a.bind_texture(texture)
 
+    def test_draw_batch(self):
+        a = shaders.Flat3D()
+        matrices = memoryview(array.array('f', [0.0]*16*3)).cast('B').cast('f', [3, 4, 4])
+        colors = memoryview(array.array('d', [1.0]*4*3)).cast('B').cast('d', [3, 4])
+        a.draw_batch(gl.Mesh(), matrices)
+        a.draw_batch(gl.Mesh(), matrices, colors)
+
+    def test_draw_batch_statistics(self):
+        a = shaders.Flat3D()
+        matrices = memoryview(array.array('f', [0.0]*16*3)).cast('B').cast('f', [3, 4, 4])
+
+        gl.Renderer.statistics_enabled = True
+        gl.Renderer.reset_statistics()
+        try:
+            a.draw_batch(gl.Mesh(), matrices)
+            self.assertEqual(gl.Renderer.statistics['draw_calls'], 3)
+            self.assertEqual(gl.Renderer.statistics['program_switches'], 1)
+        finally:
+            gl.Renderer.statistics_enabled = False
+
+    def test_draw_batch_link_async(self):
+        a = shaders.Flat3D()
+        break_link(a)
+
+        # The batch draw checks the pending link first, same as draw()
+        matrices = memoryview(array.array('f', [0.0]*16)).cast('B').cast('f', [1, 4, 4])
+        with self.assertRaisesRegex(RuntimeError, "linking failed"):
+            a.draw_batch(gl.Mesh(), matrices)
+
+    def test_link_async_destroyed(self):
+        a = shaders.Flat2D()
+        id = a.id
+        a.link_async()
+        del a
+
+        # The ID may get reused by a new program, which shouldn't inherit the
+        # pending link check from the destroyed one
+        b = gl.AbstractShaderProgram()
+        if b.id != id:
+            self.skipTest("the program ID wasn't reused")
+        b.draw(gl.Mesh())
+
+    def test_draw_release_gil(self):
+        a = shaders.Flat2D()
+        gl.AbstractShaderProgram.release_gil_on_draw = True
+        try:
+            a.draw(gl.Mesh())
+        finally:
+            gl.AbstractShaderProgram.release_gil_on_draw = False
+
+    def test_draw_batch_render(self):
+        renderbuffer = gl.Renderbuffer()
+        renderbuffer.set_storage(gl.RenderbufferFormat.RGBA8, (4, 4))
+
+        framebuffer = gl.Framebuffer(((0, 0), (4, 4)))
+        framebuffer.attach_renderbuffer(gl.Framebuffer.ColorAttachment(0), renderbuffer)
+        framebuffer.bind()
+
+        gl.Renderer.clear_color = Color4(0.0, 0.0, 0.0, 1.0)
+        framebuffer.clear(gl.FramebufferClear.COLOR)
+
+        # A fullscreen square squashed to the left and to the right half of
+        # the framebuffer, rows first
+        matrices = memoryview(array.array('f', [
+            0.5, 0.0, -0.5,
+            0.0, 1.0, 0.0,
+            0.0, 0.0, 1.0,
+
+            0.5, 0.0, 0.5,
+            0.0, 1.0, 0.0,
+            0.0, 0.0, 1.0])).cast('B').cast('f', [2, 3, 3])
+        colors = memoryview(array.array('f', [
+            1.0, 0.0, 0.0, 1.0,
+            0.0, 0.0, 1.0, 1.0])).cast('B').cast('f', [2, 4])
+        shaders.Flat2D().draw_batch(meshtools.compile(primitives.square_solid()), matrices, colors)
+
+        a = Image2D(PixelFormat.RGBA8_UNORM)
+        framebuffer.read(Range2Di.from_size((0, 0), (4, 4)), a)
+        self.assertEqual(a.size, Vector2i(4, 4))
+        for y in range(4):
+            self.assertEqual(ord(a.pixels[y, 0, 0]), 0xff)
+            self.assertEqual(ord(a.pixels[y, 0, 2]), 0x00)
+            self.assertEqual(ord(a.pixels[y, 3, 0]), 0x00)
+            self.assertEqual(ord(a.pixels[y, 3, 2]), 0xff)
+
+    def test_draw_batch_errors(self):
+        a = shaders.Flat2D()
+        matrices = memoryview(array.array('f', [0.0]*9*3)).cast('B').cast('f', [3, 3, 3])
+        colors = memoryview(array.array('f', [1.0]*4*2)).cast('B').cast('f', [2, 4])
+        with self.assertRaisesRegex(BufferError, "expected 3 dimensions but got 1"):
+            a.draw_batch(gl.Mesh(), array.array('f', [0.0]*9))
+        with self.assertRaisesRegex(BufferError, "expected 3x3 elements but got 4x4"):
+            a.draw_batch(gl.Mesh(), memoryview(array.array('f', [0.0]*16)).cast('B').cast('f', [1, 4, 4]))
+        with self.assertRaisesRegex(BufferError, "expected format f or d but got i"):
+            a.draw_batch(gl.Mesh(), memoryview(array.array('i', [0]*9)).cast('B').cast('i', [1, 3, 3]))
+        with self.assertRaisesRegex(ValueError, "expected 3 colors but got 2"):
+            a.draw_batch(gl.Mesh(), matrices, colors)
+
 class VertexColor(GLTestCase):
     def test_init(self):
         a = shaders.VertexColor2D()
@@ -70,6 +183,11 @@ class VertexColor(GLTestCase):
             Matrix3.translation(Vector2.x_axis())@
             Matrix3.rotation(Deg(35.0)))
 
+    def test_draw_batch(self):
+        a = shaders.VertexColor2D()
+        matrices = memoryview(array.array('f', [0.0]*9*3)).cast('B').cast('f', [3, 3, 3])
+        a.draw_batch(gl.Mesh(), matrices)
+
 class Phong(GLTestCase):
     def test_init(self):
         a = shaders.Phong()
@@ -91,6 +209,8 @@ class Phong(GLTestCase):
         a.projection_matrix = Matrix4.zero_init()
         a.light_positions = [(0.5, 1.0, 0.3), Vector3()]
         a.light_colors = [Color4(), Color4()]
+        a.light_positions = memoryview(array.array('d', [0.5, 1.0, 0.3, 0.0, 0.0, 0.0])).cast('B').cast('d', [2, 3])
+        a.light_colors = memoryview(array.array('f', [1.0]*8)).cast('B').cast('f', [2, 4])
         a.alpha_mask = 0.3
 
         texture = gl.Texture2D()
@@ -109,6 +229,10 @@ class Phong(GLTestCase):
             a.light_positions = []
         with self.assertRaisesRegex(ValueError, "expected 1 items but got 0"):
             a.light_colors = []
+        with self.assertRaisesRegex(ValueError, "expected 1 items but got 2"):
+            a.light_positions = memoryview(array.array('f', [0.0]*6)).cast('B').cast('f', [2, 3])
+        with self.assertRaisesRegex(BufferError, "expected 4 components but got 3"):
+            a.light_colors = memoryview(array.array('f', [0.0]*3)).cast('B').cast('f', [1, 3])
 
         texture = gl.Texture2D()
         with self.assertRaisesRegex(AttributeError, "the shader was not created with ambient texture enabled"):
@@ -121,3 +245,15 @@ class Phong(GLTestCase):
             a.bind_normal_texture(texture)
         with self.assertRaisesRegex(AttributeError, "the shader was not created with any textures enabled"):
             a.bind_textures(diffuse=texture)
+
+    def test_draw_batch(self):
+        a = shaders.Phong()
+        transformations = memoryview(array.array('f', [0.0]*16*2)).cast('B').cast('f', [2, 4, 4])
+        normals = memoryview(array.array('f', [0.0]*9*2)).cast('B').cast('f', [2, 3, 3])
+        colors = memoryview(array.array('f', [1.0]*4*2)).cast('B').cast('f', [2, 4])
+        a.draw_batch(gl.Mesh(), transformations)
+        a.draw_batch(gl.Mesh(), transformations, normals, colors)
+        a.draw_batch(gl.Mesh(), transformations, diffuse_colors=colors)
+
+        with self.assertRaisesRegex(ValueError, "expected 2 normal matrices but got 1"):
+            a.draw_batch(gl.Mesh(), transformations, normals[:1])
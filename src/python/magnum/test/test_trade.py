@@ -98,6 +98,28 @@ class MeshData(unittest.TestCase):
         self.assertEqual(mesh.primitive, MeshPrimitive.TRIANGLES)
         # TODO: test more, once it's exposed
 
+class AnimationData(unittest.TestCase):
+    def test(self):
+        # The only way to get an animation instance is through a manager
+        importer = trade.ImporterManager().load_and_instantiate('TinyGltfImporter')
+        importer.open_file(os.path.join(os.path.dirname(__file__), 'animation.gltf'))
+        self.assertEqual(importer.animation_count, 1)
+        self.assertEqual(importer.animation_name(0), 'Move')
+        self.assertEqual(importer.animation_for_name('Move'), 0)
+
+        animation = importer.animation(0)
+        self.assertEqual(animation.duration, Range1D(0.0, 2.0))
+        self.assertEqual(animation.track_count, 2)
+        self.assertEqual(animation.track_type(0), trade.AnimationTrackType.VECTOR3)
+        self.assertEqual(animation.track_result_type(0), trade.AnimationTrackType.VECTOR3)
+        self.assertEqual(animation.track_target_type(0), trade.AnimationTrackTargetType.TRANSLATION3D)
+        self.assertEqual(animation.track_target(0), 0)
+        self.assertEqual(animation.track_target_type(1), trade.AnimationTrackTargetType.SCALING3D)
+        self.assertEqual(animation.track_target(1), 1)
+
+        with self.assertRaises(IndexError):
+            animation.track_type(2)
+
 class Importer(unittest.TestCase):
     def test(self):
         manager = trade.ImporterManager()
@@ -116,6 +138,11 @@ class Importer(unittest.TestCase):
         importer = trade.ImporterManager().load_and_instantiate('StbImageImporter')
         self.assertFalse(importer.is_opened)
 
+        with self.assertRaisesRegex(RuntimeError, "no file opened"):
+            importer.animation_count
+        with self.assertRaisesRegex(RuntimeError, "no file opened"):
+            importer.animation(0)
+
         with self.assertRaisesRegex(RuntimeError, "no file opened"):
             importer.mesh_count
         with self.assertRaisesRegex(RuntimeError, "no file opened"):
@@ -28,6 +28,7 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/AnimationData.h>
 #include <Magnum/Trade/ImageData.h>
 #include <Magnum/Trade/MeshData.h>
 
@@ -154,6 +155,15 @@ template<class R, class Arg1, R(Trade::AbstractImporter::*f)(Arg1)> R checkOpene
     return (self.*f)(arg1);
 }
 
+template<class R, R(Trade::AnimationData::*f)(UnsignedInt) const> R checkTrackBounds(Trade::AnimationData& self, UnsignedInt id) {
+    if(id >= self.trackCount()) {
+        PyErr_SetNone(PyExc_IndexError);
+        throw py::error_already_set{};
+    }
+
+    return (self.*f)(id);
+}
+
 template<class R, R(Trade::AbstractImporter::*f)(UnsignedInt), UnsignedInt(Trade::AbstractImporter::*bounds)() const> R checkOpenedBounds(Trade::AbstractImporter& self, UnsignedInt id) {
     if(!self.isOpened()) {
         PyErr_SetString(PyExc_RuntimeError, "no file opened");
@@ -232,6 +242,51 @@ void trade(py::module& m) {
         .def_property_readonly("index_count", &Trade::MeshData::indexCount)
         .def_property_readonly("attribute_count", static_cast<UnsignedInt(Trade::MeshData::*)() const>(&Trade::MeshData::attributeCount));
 
+    py::enum_<Trade::AnimationTrackType>{m, "AnimationTrackType", "Type of animation track data"}
+        .value("BOOL", Trade::AnimationTrackType::Bool)
+        .value("FLOAT", Trade::AnimationTrackType::Float)
+        .value("UNSIGNED_INT", Trade::AnimationTrackType::UnsignedInt)
+        .value("INT", Trade::AnimationTrackType::Int)
+        .value("BOOL_VECTOR2", Trade::AnimationTrackType::BoolVector2)
+        .value("BOOL_VECTOR3", Trade::AnimationTrackType::BoolVector3)
+        .value("BOOL_VECTOR4", Trade::AnimationTrackType::BoolVector4)
+        .value("VECTOR2", Trade::AnimationTrackType::Vector2)
+        .value("VECTOR2UI", Trade::AnimationTrackType::Vector2ui)
+        .value("VECTOR2I", Trade::AnimationTrackType::Vector2i)
+        .value("VECTOR3", Trade::AnimationTrackType::Vector3)
+        .value("VECTOR3UI", Trade::AnimationTrackType::Vector3ui)
+        .value("VECTOR3I", Trade::AnimationTrackType::Vector3i)
+        .value("VECTOR4", Trade::AnimationTrackType::Vector4)
+        .value("VECTOR4UI", Trade::AnimationTrackType::Vector4ui)
+        .value("VECTOR4I", Trade::AnimationTrackType::Vector4i)
+        .value("COMPLEX", Trade::AnimationTrackType::Complex)
+        .value("QUATERNION", Trade::AnimationTrackType::Quaternion)
+        .value("DUAL_QUATERNION", Trade::AnimationTrackType::DualQuaternion)
+        .value("CUBIC_HERMITE1D", Trade::AnimationTrackType::CubicHermite1D)
+        .value("CUBIC_HERMITE2D", Trade::AnimationTrackType::CubicHermite2D)
+        .value("CUBIC_HERMITE3D", Trade::AnimationTrackType::CubicHermite3D)
+        .value("CUBIC_HERMITE_COMPLEX", Trade::AnimationTrackType::CubicHermiteComplex)
+        .value("CUBIC_HERMITE_QUATERNION", Trade::AnimationTrackType::CubicHermiteQuaternion);
+
+    py::enum_<Trade::AnimationTrackTargetType>{m, "AnimationTrackTargetType", "Target of an animation track"}
+        .value("TRANSLATION2D", Trade::AnimationTrackTargetType::Translation2D)
+        .value("TRANSLATION3D", Trade::AnimationTrackTargetType::Translation3D)
+        .value("ROTATION2D", Trade::AnimationTrackTargetType::Rotation2D)
+        .value("ROTATION3D", Trade::AnimationTrackTargetType::Rotation3D)
+        .value("SCALING2D", Trade::AnimationTrackTargetType::Scaling2D)
+        .value("SCALING3D", Trade::AnimationTrackTargetType::Scaling3D)
+        .value("CUSTOM", Trade::AnimationTrackTargetType::Custom);
+
+    /* Track data are not exposed directly, they get consumed by
+       scenegraph.trs.AnimationPlayer3D */
+    py::class_<Trade::AnimationData>{m, "AnimationData", "Animation clip data"}
+        .def_property_readonly("duration", &Trade::AnimationData::duration, "Animation duration")
+        .def_property_readonly("track_count", &Trade::AnimationData::trackCount, "Track count")
+        .def("track_type", checkTrackBounds<Trade::AnimationTrackType, &Trade::AnimationData::trackType>, "Track value type", py::arg("id"))
+        .def("track_result_type", checkTrackBounds<Trade::AnimationTrackType, &Trade::AnimationData::trackResultType>, "Track result type", py::arg("id"))
+        .def("track_target_type", checkTrackBounds<Trade::AnimationTrackTargetType, &Trade::AnimationData::trackTargetType>, "Track target type", py::arg("id"))
+        .def("track_target", checkTrackBounds<UnsignedInt, &Trade::AnimationData::trackTarget>, "Track target", py::arg("id"));
+
     py::class_<Trade::ImageData1D> imageData1D{m, "ImageData1D", "One-dimensional image data"};
     py::class_<Trade::ImageData2D> imageData2D{m, "ImageData2D", "Two-dimensional image data"};
     py::class_<Trade::ImageData3D> imageData3D{m, "ImageData3D", "Three-dimensional image data"};
@@ -267,6 +322,11 @@ void trade(py::module& m) {
         .def("close", &Trade::AbstractImporter::close, "Close currently opened file")
 
         /** @todo all other data types */
+        .def_property_readonly("animation_count", checkOpened<UnsignedInt, &Trade::AbstractImporter::animationCount>, "Animation count")
+        .def("animation_for_name", checkOpened<Int, const std::string&, &Trade::AbstractImporter::animationForName>, "Animation ID for given name")
+        .def("animation_name", checkOpenedBounds<std::string, &Trade::AbstractImporter::animationName, &Trade::AbstractImporter::animationCount>, "Animation name", py::arg("id"))
+        .def("animation", checkOpenedBoundsResult<Trade::AnimationData, &Trade::AbstractImporter::animation, &Trade::AbstractImporter::animationCount>, "Animation", py::arg("id"))
+
         .def_property_readonly("mesh_count", checkOpened<UnsignedInt, &Trade::AbstractImporter::meshCount>, "Mesh count")
         .def("mesh_level_count", checkOpenedBounds<UnsignedInt, &Trade::AbstractImporter::meshLevelCount, &Trade::AbstractImporter::meshCount>, "Mesh level count", py::arg("id"))
         .def("mesh_for_name", checkOpened<Int, const std::string&, &Trade::AbstractImporter::meshForName>, "Mesh ID for given name")